@@ -0,0 +1,440 @@
+/**
+* @file GLStub.cpp
+*
+* Entity::Buffer GLReLXgȂœ߂̑֎.
+* UBOSSBOւ݂̏̓VXe̔zɑ΂čs.
+* VF[_AeNX`AbVID̃IuWFNgƂč쐬.
+*/
+#include "UniformBuffer.h"
+#include "BufferObject.h"
+#include "Mesh.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "GLState.h"
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+#include <string.h>
+#include <algorithm>
+
+namespace /* unnamed */ {
+	/// UBȎɎgVXe.
+	std::unordered_map<const UniformBuffer*, std::vector<uint8_t>> cpuBufferList;
+	/// obt@IuWFNg̑ɎgVXe.
+	std::unordered_map<const BufferObject*, std::vector<uint8_t>> cpuBufferObjectList;
+	/// 쐬IuWFNgɊ蓖ĂID.
+	GLuint lastObjectId = 0;
+}
+
+/**
+* Uniformobt@쐬.
+*
+* @param size         obt@̃oCgTCY.
+* @param bindingPoint obt@蓖ĂoCfBOE|Cg.
+* @param name         obt@(fobOp).
+* @param frameCount   Oobt@̃t[.
+*
+* @return 쐬Uniformobt@ւ̃|C^.
+*/
+UniformBufferPtr UniformBuffer::Create(GLsizeiptr size, GLuint bindingPoint, const char* name, int frameCount){
+	struct Impl : UniformBuffer {
+		Impl() {}
+		~Impl() {}
+	};
+	UniformBufferPtr p = std::make_shared<Impl>();
+	if (!p) {
+		std::cerr << "ERROR: UBO '" << name << "'̍쐬Ɏs" << std::endl;
+		return{};
+	}
+	const GLintptr alignment = OffsetAlignment();
+	p->frameCount = frameCount;
+	p->frameSize = frameCount > 1 ? (size + alignment - 1) / alignment * alignment : size;
+	cpuBufferList[p.get()].resize(p->frameSize * frameCount);
+	p->size = size;
+	p->bindingPoint = bindingPoint;
+	p->name = name;
+	return p;
+}
+
+/**
+* BindBufferRange ɎwłItZbg̋E擾.
+*
+* @return m̎ōő̋E(256oCg).
+*/
+GLintptr UniformBuffer::OffsetAlignment(){
+	return 256;
+}
+
+/**
+* fXgN^.
+*/
+UniformBuffer::~UniformBuffer(){
+	cpuBufferList.erase(this);
+}
+
+/**
+* Uniformobt@Ƀf[^].
+*
+* @param data   ]f[^ւ̃|C^.
+* @param offset ]̃oCgItZbg.
+* @param size   ]oCg.
+*
+* @retval true  ].
+* @retval false ]s.
+*/
+bool UniformBuffer::BufferSubData(const GLvoid* data, GLintptr offset, GLsizeiptr size){
+	if (offset + size > this->size) {
+		return false;
+	}
+	if (offset == 0 && size == 0) {
+		size = this->size;
+	}
+	memcpy(cpuBufferList[this].data() + FrameOffset() + offset, data, size);
+	return true;
+}
+
+/**
+* Oobt@̎̃t[̗̈ɐ؂ւ.
+*/
+void UniformBuffer::NextFrame(){
+	if (frameCount > 1) {
+		frameIndex = (frameIndex + 1) % frameCount;
+	}
+}
+
+/**
+* w肳ꂽ͈͂oCfBOE|CgɊ蓖Ă(Ȃ).
+*/
+void UniformBuffer::BindBufferRange(GLintptr offset, GLsizeiptr size) const{
+}
+
+/**
+* UBȎ̃VXe擾.
+*
+* @return VXeւ̃|C^.
+*/
+void* UniformBuffer::MapBuffer() const{
+	return cpuBufferList[this].data() + FrameOffset();
+}
+
+/**
+* obt@̊蓖Ă(Ȃ).
+*/
+void UniformBuffer::UnmapBuffer() const{
+}
+
+/**
+* obt@IuWFNg̑̃VXemۂ.
+*
+* @param target gpȂ.
+* @param size   mۂoCg.
+* @param data   f[^ւ̃|C^. nullptrȂ0Ŗ߂.
+* @param usage  gpȂ.
+*/
+void BufferObject::Init(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage){
+	Destroy();
+	std::vector<uint8_t>& buf = cpuBufferObjectList[this];
+	buf.resize(size);
+	if (data) {
+		memcpy(buf.data(), data, size);
+	}
+	id = ++lastObjectId;
+	this->size = size;
+}
+
+/**
+* obt@IuWFNg̑̃VXe.
+*/
+void BufferObject::Destroy(){
+	if (id) {
+		cpuBufferObjectList.erase(this);
+		id = 0;
+		size = 0;
+	}
+}
+
+/**
+* obt@IuWFNg̑̃VXe擾.
+*
+* @return VXeւ̃|C^.
+*/
+void* BufferObject::MapBuffer(GLenum target, GLsizeiptr size) const{
+	return cpuBufferObjectList[this].data();
+}
+
+/**
+* obt@̊蓖Ă(Ȃ).
+*/
+void BufferObject::UnmapBuffer(GLenum target) const{
+}
+
+/**
+* w肳ꂽ͈͂oCfBOE|CgɊ蓖Ă(Ȃ).
+*/
+void BufferObject::BindBufferRange(GLenum target, GLuint index, GLintptr offset, GLsizeiptr size) const{
+}
+
+/**
+* GL_SHADER_STORAGE_BUFFER  BindBufferRange ɎwłItZbg̋E擾.
+*
+* @return m̎ōő̋E(256oCg).
+*/
+GLintptr BufferObject::StorageOffsetAlignment(){
+	return 256;
+}
+
+/**
+* RXgN^.
+*/
+Texture::Texture() : texId(0), width(0), height(0){
+}
+
+/**
+* fXgN^.
+*/
+Texture::~Texture(){
+}
+
+/**
+* ̃eNX`쐬.
+*
+* @param width  eNX`̕(sNZ).
+* @param height eNX`̍(sNZ).
+*
+* @return 쐬eNX`ւ̃|C^.
+*/
+TexturePtr Texture::Create(int width, int height, GLenum iformat, GLenum format, const void* data){
+	struct Impl : Texture { Impl() {} ~Impl() {} };
+	TexturePtr p = std::make_shared<Impl>();
+	p->texId = ++lastObjectId;
+	p->width = width;
+	p->height = height;
+	return p;
+}
+
+/**
+* ̃eNX`z쐬.
+*
+* @param width      ew̕(sNZ).
+* @param height     ew̍(sNZ).
+* @param layerCount w̐.
+*
+* @return 쐬eNX`zւ̃|C^.
+*/
+TexturePtr Texture::CreateArray(int width, int height, GLenum iformat, int layerCount){
+	struct Impl : Texture { Impl() {} ~Impl() {} };
+	TexturePtr p = std::make_shared<Impl>();
+	p->texId = ++lastObjectId;
+	p->width = width;
+	p->height = height;
+	p->target = GL_TEXTURE_2D_ARRAY;
+	p->iformat = iformat;
+	p->layerCount = layerCount;
+	return p;
+}
+
+/**
+* eNX`z̖gp̑w蓖Ă.
+*
+* @param array 蓖Č̃eNX`z.
+*
+* @return 蓖Ăw\eNX`ւ̃|C^. 󂫂Ȃnullptr.
+*/
+TexturePtr Texture::CreateLayer(const TexturePtr& array, GLenum format, const void* data){
+	if (!array || array->IsFull()) {
+		return{};
+	}
+	struct Impl : Texture { Impl() {} ~Impl() {} };
+	TexturePtr p = std::make_shared<Impl>();
+	p->texId = array->texId;
+	p->width = array->width;
+	p->height = array->height;
+	p->target = GL_TEXTURE_2D_ARRAY;
+	p->layer = array->usedLayerCount++;
+	p->array = array;
+	return p;
+}
+
+namespace Mesh {
+	/**
+	* RXgN^.
+	*/
+	Mesh::Mesh(const std::string& meshName, size_t begin, size_t end) :
+		name(meshName), beginMaterial(begin), endMaterial(end){
+	}
+
+	/**
+	* bV`悷(Ȃ).
+	*/
+	void Mesh::Draw(const BufferPtr& buffer, GLsizei instanceCount) const{
+	}
+
+	/**
+	* bVobt@쐬.
+	*
+	* @return 쐬bVobt@ւ̃|C^.
+	*         SĂ̊Ԑڕ`̕@ɑΉĂ̂ƂĈAԂł͊Ԑڕ`gȂ.
+	*/
+	BufferPtr Buffer::Create(int vboSize, int iboSize, VertexFormat format){
+		struct Impl : Buffer { Impl() {} ~Impl() {} };
+		BufferPtr p = std::make_shared<Impl>();
+		p->vertexFormat = format;
+		p->supportedIndirectMode = IndirectMode::MultiDraw;
+		return p;
+	}
+
+	/**
+	* fXgN^.
+	*/
+	Buffer::~Buffer(){
+	}
+
+	/**
+	* t@C𖼑OƂ1}eÃbVǉ.
+	* E͌_𒆐SƂ2̗̂Ƃ.
+	*
+	* @param filename bVƂĎg.
+	*
+	* @retval true  ǉ.
+	*/
+	bool Buffer::LoadMeshFromFile(const char* filename){
+		struct Impl : Mesh {
+			Impl(const std::string& n, size_t b, size_t e) : Mesh(n, b, e) {}
+			~Impl() {}
+		};
+		// Op`̐𔼕ɂڍדxA{̂Ɠ؂ւŎ.
+		static const float lodScreenSize[maxLodCount] = { 1.0f, 0.2f, 0.1f, 0.05f };
+		MeshPtr mesh;
+		for (size_t level = 0; level < maxLodCount; ++level) {
+			const std::string name = level ? std::string(filename) + ".LOD" + std::to_string(level) : std::string(filename);
+			const size_t begin = materialList.size();
+			materialList.push_back({ GL_UNSIGNED_SHORT, 0, nullptr, 0, glm::vec4(1) });
+			MeshPtr p = std::make_shared<Impl>(name, begin, materialList.size());
+			p->bounds.min = glm::vec3(-1);
+			p->bounds.max = glm::vec3(1);
+			p->bounds.radius = std::sqrt(3.0f);
+			p->triangleCount = 1024 >> level;
+			meshList.insert(std::make_pair(name, p));
+			if (level) {
+				mesh->lodList.push_back({ p, lodScreenSize[level] });
+			} else {
+				mesh = p;
+			}
+		}
+		return true;
+	}
+
+	/**
+	* bV擾.
+	*
+	* @param name 擾bV̖O.
+	*
+	* @return nameƓObV. Ȃnullptr.
+	*/
+	const MeshPtr& Buffer::GetMesh(const char* name) const{
+		auto itr = meshList.find(name);
+		if (itr == meshList.end()) {
+			static const MeshPtr dummy;
+			return dummy;
+		}
+		return itr->second;
+	}
+
+	/**
+	* }eA擾.
+	*/
+	const Material& Buffer::GetMaterial(size_t index) const{
+		return materialList[index];
+	}
+
+	/**
+	* VAOOpenGL̏Ώۂɐݒ肷(Ȃ).
+	*/
+	void Buffer::BindVAO() const{
+	}
+
+	/**
+	* Ԑڕ`R}h̔s@ݒ肷.
+	*/
+	void Buffer::SetIndirectMode(IndirectMode mode){
+		indirectMode = std::min(mode, supportedIndirectMode);
+	}
+
+	/**
+	* Ԑڕ`R}h𔭍s(Ȃ).
+	*/
+	void Buffer::DrawIndirect(GLuint commandBuffer, const DrawElementsIndirectCommand* commands, GLsizei first, GLsizei count) const{
+	}
+} // namespace Mesh
+
+namespace Shader {
+	/**
+	* ̃VF[_vO쐬.
+	*
+	* @param vsFilename vOƂĎg.
+	*
+	* @return 쐬vOւ̃|C^.
+	*/
+	ProgramPtr Program::Create(const char* vsFilename, const char* fsFilename, const DefineList& defines){
+		struct Impl : Program { Impl() {} ~Impl() {} };
+		ProgramPtr p = std::make_shared<Impl>();
+		p->program = ++lastObjectId;
+		p->samplerCount = 2;
+		p->name = vsFilename;
+		return p;
+	}
+
+	/**
+	* fXgN^.
+	*/
+	Program::~Program(){
+	}
+
+	/**
+	* `pvOɐݒ肷(Ȃ).
+	*/
+	void Program::UseProgram(){
+	}
+
+	/**
+	* eNX`eNX`EC[WEjbgɊ蓖Ă(Ȃ).
+	*
+	* @retval true  蓖Ă.
+	* @retval false 蓖ĂȂ.
+	*/
+	bool Program::BindTexture(GLenum unit, GLenum type, GLuint texture){
+		return unit - GL_TEXTURE0 < static_cast<GLenum>(samplerCount);
+	}
+} // namespace Shader
+
+namespace GLState {
+	/**
+	* @\̗L/؂ւ(Ȃ).
+	*/
+	void Enable(GLenum cap, bool enable){
+	}
+
+	/**
+	* uȟWݒ肷(Ȃ).
+	*/
+	void BlendFunc(GLenum src, GLenum dst){
+	}
+
+	/**
+	* [xobt@ւ݂̏L/ɂ(Ȃ).
+	*/
+	void DepthMask(bool enable){
+	}
+
+	/**
+	* [xeXg̔r֐ݒ肷(Ȃ).
+	*/
+	void DepthFunc(GLenum func){
+	}
+
+	/**
+	* [x͈̔͂ݒ肷(Ȃ).
+	*/
+	void DepthRange(GLclampd zNear, GLclampd zFar){
+	}
+} // namespace GLState
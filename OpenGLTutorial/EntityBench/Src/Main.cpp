@@ -0,0 +1,364 @@
+/**
+* @file Main.cpp
+*
+* Entity::Buffer::Update  Draw ̐\vx`}[N.
+* GLReLXg쐬ɎsAʂJSON`ŕWo͂ɏo.
+*
+* g: EntityBench [V[] [--frames n] [--toroids n] [--shots n] [--speed x] [--density x] [--no-instancing]
+*         [--indirect multidraw|loop] [--texture-array]
+*/
+#include "Entity.h"
+#include "Uniform.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace /* unnamed */ {
+
+	/// GeBeB̏Փ˃O[vID(GameState::EntityGroupId Ɠl).
+	enum EntityGroupId {
+		EntityGroupId_PlayerShot = 2,
+		EntityGroupId_Enemy = 3,
+		EntityGroupId_Others = 5,
+	};
+
+	const double frameDelta = 1.0 / 60.0; ///< 1t[̌oߎ(b).
+	const int warmupFrames = 60; ///< v珜OJñt[.
+
+	/**
+	* x`}[NV[̃p[^.
+	*/
+	struct SceneParameter {
+		const char* name; ///< V[.
+		int toroidCount; ///< ʓɈێ~Ղ̐.
+		int shotCount; ///< ʓɈێe̐.
+		float toroidSpeed; ///< ~Ղ̑x.
+		float shotSpeed; ///< ȇx.
+		float density; ///< o͈͂̒Pʖʐς̃GeBeB(dȂ̖x).
+		int frames; ///< vt[.
+		int maxEntityCount; ///< GeBeB̍ő吔.
+	};
+
+	/// V[Xg. submit ͕`施߂̔švpŁAՓ˔sȂ.
+	const SceneParameter sceneList[] = {
+		{ "sparse", 50, 20, 16, 80, 0.05f, 600, 1024 },
+		{ "game", 150, 40, 16, 80, 0.1f, 600, 1024 },
+		{ "dense", 300, 100, 16, 80, 0.5f, 600, 1024 },
+		{ "swarm", 500, 200, 4, 40, 2.0f, 600, 1024 },
+		{ "submit", 5000, 0, 16, 80, 0.5f, 300, 8192 },
+	};
+
+	/**
+	* V[̌v.
+	*/
+	struct SceneResult {
+		double entityCount = 0; ///< vGeBeB̍v.
+		double integrationTime = 0; ///< WƏԂ̍XVɂԂ̍v(b).
+		double collisionTime = 0; ///< Փ˔ɂԂ̍v(b).
+		double cullingTime = 0; ///< JOɂԂ̍v(b).
+		double visibleCount = 0; ///< ̓ɂGeBeB̍v.
+		double culledCount = 0; ///< ̊OɂGeBeB̍v.
+		double lodReducedCount = 0; ///< ڍדxbVŕ`悵GeBeB̍v.
+		double uploadTime = 0; ///< UBO̍XVɂԂ̍v(b).
+		double uploadBytes = 0; ///< UBOɏ񂾃oCg̍v.
+		double sortTime = 0; ///< `L[̕בւɂԂ̍v(b).
+		double drawTime = 0; ///< `L[̑ɂԂ̍v(b).
+		Entity::DrawStats drawStats; ///< `Ԃ̕ύX̐̍v.
+		size_t collisionTestCount = 0; ///< Փ˔sg̐̍v.
+		size_t handlerCallCount = 0; ///< ՓˉnȟĂяo񐔂̍v.
+		size_t spawnSkipCount = 0; ///< 󂫂ȂǉȂGeBeB̐.
+	};
+
+	/**
+	* o͈͂̊OɏoGeBeB폜.
+	*/
+	struct UpdateWaveEntity {
+		void operator()(Entity::Entity& entity, double delta) {
+			const glm::vec3 pos = entity.Position();
+			if (std::abs(pos.x) > halfSize || std::abs(pos.z) > halfSize) {
+				--*pCount;
+				entity.Destroy();
+				return;
+			}
+			// ~ՂƓlɉ].
+			float rot = glm::angle(entity.Rotation());
+			rot += glm::radians(15.0f) * static_cast<float>(delta);
+			entity.Rotation(glm::angleAxis(rot, glm::vec3(0, 1, 0)));
+		}
+		float halfSize; ///< o͈͂̑傫̔.
+		int* pCount; ///< ނ̃GeBeB̐.
+	};
+
+	/**
+	* ̑̃GeBeB. 莞Ԃō폜.
+	*/
+	struct UpdateBlast {
+		void operator()(Entity::Entity& entity, double delta) {
+			timer += delta;
+			if (timer >= 0.5) {
+				--*pCount;
+				entity.Destroy();
+				return;
+			}
+			entity.Scale(glm::vec3(static_cast<float>(1 + timer * 4)));
+		}
+		int* pCount; ///< ̐.
+		double timer = 0;
+	};
+
+	/**
+	* 1̃V[sAvʂԂ.
+	*
+	* @param param         V[̃p[^.
+	* @param useInstancing CX^X`p̃VF[_ݒ肷Ȃtrue.
+	* @param indirectMode  Ԑڕ`̕@. None ȂԐڕ`p̃VF[_ݒ肵Ȃ.
+	* @param useTextureArray SẴeNX`1̃eNX`z̑wɂȂtrue.
+	*
+	* @return v.
+	*/
+	SceneResult RunScene(const SceneParameter& param, bool useInstancing, Mesh::IndirectMode indirectMode,
+		bool useTextureArray) {
+		SceneResult result;
+		const size_t maxEntityCount = param.maxEntityCount;
+		Entity::BufferPtr buffer = Entity::Buffer::Create(
+			maxEntityCount, sizeof(Uniform::VertexData), 0, "VertexData");
+		if (!buffer) {
+			return result;
+		}
+
+		// o͈͂̑傫𖧓x狁߂.
+		const int totalCount = param.toroidCount + param.shotCount;
+		const float halfSize = std::sqrt(totalCount / std::max(param.density, 0.001f)) * 0.5f;
+		std::mt19937 rand(1);
+		std::uniform_real_distribution<float> rndPos(-halfSize, halfSize);
+
+		static const Entity::CollisionData colToroid = { glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1) };
+		static const Entity::CollisionData colShot = { glm::vec3(-0.25f, -0.25f, -0.25f), glm::vec3(0.25f, 0.25f, 0.25f) };
+		// ۂ̃Q[Ɠx̎ނ̃VF[_AeNX`AbVpӂ.
+		Mesh::BufferPtr meshBuffer = Mesh::Buffer::Create(0, 0);
+		meshBuffer->SetIndirectMode(indirectMode);
+		static const char* const meshNameList[] = { "Toroid", "Shot", "Blast" };
+		for (const char* name : meshNameList) {
+			meshBuffer->LoadMeshFromFile(name);
+		}
+		const Mesh::MeshPtr& meshToroid = meshBuffer->GetMesh("Toroid");
+		const Mesh::MeshPtr& meshShot = meshBuffer->GetMesh("Shot");
+		const Mesh::MeshPtr& meshBlast = meshBuffer->GetMesh("Blast");
+		const Shader::ProgramPtr progLit = Shader::Program::Create("Tutorial", "Tutorial");
+		const Shader::ProgramPtr progUnlit = Shader::Program::Create("NonLighting", "NonLighting");
+		if (useInstancing) {
+			progLit->Instanced(Shader::Program::Create("TutorialInstanced", "Tutorial"));
+			progUnlit->Instanced(Shader::Program::Create("NonLightingInstanced", "NonLighting"));
+		}
+		if (indirectMode != Mesh::IndirectMode::None) {
+			progLit->Indirect(Shader::Program::Create("TutorialIndirect", "Tutorial"));
+			progUnlit->Indirect(Shader::Program::Create("NonLightingIndirect", "NonLighting"));
+			buffer->Indirect(true);
+		}
+		buffer->Payload<Uniform::CompactVertexData>(progUnlit);
+		// eNX`zgꍇAeNX`̈Ⴂ͕`Pʂ𕪂ȂȂ.
+		const TexturePtr texArray = useTextureArray ? Texture::CreateArray(1, 1, GL_RGBA8, 4) : nullptr;
+		const auto createTexture = [&texArray]() {
+			return texArray ? Texture::CreateLayer(texArray, GL_RGBA, nullptr) : Texture::Create(1, 1, GL_RGBA8, GL_RGBA, nullptr);
+		};
+		const TexturePtr texNormal = createTexture();
+		const TexturePtr texToroid[2] = { createTexture(), texNormal };
+		const TexturePtr texShot[2] = { createTexture(), texNormal };
+		const TexturePtr texBlast[2] = { createTexture(), texNormal };
+
+		Entity::Buffer& b = *buffer;
+		int toroidCount = 0;
+		int shotCount = 0;
+		int blastCount = 0;
+		b.CollisionHandler(EntityGroupId_PlayerShot, EntityGroupId_Enemy,
+			[&](Entity::Entity& lhs, Entity::Entity& rhs) {
+			// 󂫂ȂꍇA͏ȗ.
+			if (toroidCount + shotCount + blastCount < static_cast<int>(maxEntityCount) - 1) {
+				if (b.AddEntity(EntityGroupId_Others, rhs.Position(), meshBlast, texBlast, progUnlit, UpdateBlast{ &blastCount })) {
+					++blastCount;
+				}
+			}
+			--shotCount;
+			--toroidCount;
+			lhs.Destroy();
+			rhs.Destroy();
+		});
+
+		// GameEngine ƓJ.
+		const glm::mat4 matView = glm::lookAt(glm::vec3(0, 20, -8), glm::vec3(0, 0, 12), glm::vec3(0, 0, 1));
+		const glm::mat4 matProj = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 1.0f, 200.0f);
+		const Entity::Frustum frustum = Entity::MakeFrustum(matProj * matView);
+		for (int frame = 0; frame < warmupFrames + param.frames; ++frame) {
+			// VEF[uƂĕ[.
+			const auto hasSpace = [&]() {
+				return toroidCount + shotCount + blastCount < static_cast<int>(maxEntityCount) - 1;
+			};
+			for (; toroidCount < param.toroidCount; ++toroidCount) {
+				if (!hasSpace()) {
+					result.spawnSkipCount += param.toroidCount - toroidCount;
+					break;
+				}
+				Entity::Entity* p = b.AddEntity(EntityGroupId_Enemy, glm::vec3(rndPos(rand), 0, rndPos(rand)),
+					meshToroid, texToroid, progLit, UpdateWaveEntity{ halfSize, &toroidCount });
+				if (!p) {
+					result.spawnSkipCount += param.toroidCount - toroidCount;
+					break;
+				}
+				p->Velocity(glm::vec3(0, 0, -param.toroidSpeed));
+				p->Collision(colToroid);
+			}
+			for (; shotCount < param.shotCount; ++shotCount) {
+				if (!hasSpace()) {
+					result.spawnSkipCount += param.shotCount - shotCount;
+					break;
+				}
+				Entity::Entity* p = b.AddEntity(EntityGroupId_PlayerShot, glm::vec3(rndPos(rand), 0, rndPos(rand)),
+					meshShot, texShot, progUnlit, UpdateWaveEntity{ halfSize, &shotCount });
+				if (!p) {
+					result.spawnSkipCount += param.shotCount - shotCount;
+					break;
+				}
+				p->Velocity(glm::vec3(0, 0, param.shotSpeed));
+				p->Collision(colShot);
+			}
+
+			b.Update(frameDelta, matView, matProj, frustum);
+			const auto drawStart = std::chrono::steady_clock::now();
+			b.Draw(meshBuffer);
+			b.NextFrame();
+			const std::chrono::duration<double> drawTime = std::chrono::steady_clock::now() - drawStart;
+			const Entity::UpdateProfile& profile = b.Profile();
+			if (frame < warmupFrames) {
+				continue;
+			}
+			result.sortTime += profile.sortTime;
+			result.drawTime += drawTime.count();
+			const Entity::DrawStats& stats = b.GetDrawStats();
+			result.drawStats.drawCount += stats.drawCount;
+			result.drawStats.batchCount += stats.batchCount;
+			result.drawStats.drawCallCount += stats.drawCallCount;
+			result.drawStats.drawCallCountWithoutInstancing += stats.drawCallCountWithoutInstancing;
+			result.drawStats.indirectCommandCount += stats.indirectCommandCount;
+			result.drawStats.programBindCount += stats.programBindCount;
+			result.drawStats.programSkipCount += stats.programSkipCount;
+			result.drawStats.textureBindCount += stats.textureBindCount;
+			result.drawStats.textureSkipCount += stats.textureSkipCount;
+			result.drawStats.triangleCount += stats.triangleCount;
+			result.entityCount += static_cast<double>(profile.entityCount);
+			result.integrationTime += profile.integrationTime;
+			result.collisionTime += profile.collisionTime;
+			result.cullingTime += profile.cullingTime;
+			result.visibleCount += static_cast<double>(profile.visibleCount);
+			result.culledCount += static_cast<double>(profile.culledCount);
+			result.lodReducedCount += static_cast<double>(profile.lodReducedCount);
+			result.uploadTime += profile.uploadTime;
+			result.uploadBytes += static_cast<double>(profile.uploadBytes);
+			result.collisionTestCount += profile.collisionTestCount;
+			result.handlerCallCount += profile.handlerCallCount;
+		}
+		return result;
+	}
+
+	/**
+	* GeBeB1̃imbvZ.
+	*/
+	double NanosecondsPerEntity(double seconds, double entityCount) {
+		return entityCount > 0 ? seconds * 1.0e9 / entityCount : 0;
+	}
+
+} // unnamed namespace
+
+/// Gg[|Cg.
+int main(int argc, char** argv) {
+	const char* sceneName = nullptr;
+	SceneParameter overrides = { nullptr, -1, -1, -1, -1, -1, -1, -1 };
+	bool useInstancing = true;
+	bool useTextureArray = false;
+	Mesh::IndirectMode indirectMode = Mesh::IndirectMode::None;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--no-instancing") == 0) {
+			useInstancing = false;
+		} else if (strcmp(argv[i], "--texture-array") == 0) {
+			useTextureArray = true;
+		} else if (i + 1 < argc && strcmp(argv[i], "--indirect") == 0) {
+			++i;
+			if (strcmp(argv[i], "multidraw") == 0) {
+				indirectMode = Mesh::IndirectMode::MultiDraw;
+			} else if (strcmp(argv[i], "loop") == 0) {
+				indirectMode = Mesh::IndirectMode::Loop;
+			} else {
+				std::cerr << "ERROR: sȊԐڕ`̕@'" << argv[i] << "'" << std::endl;
+				return 1;
+			}
+		} else if (i + 1 < argc && strcmp(argv[i], "--frames") == 0) {
+			overrides.frames = atoi(argv[++i]);
+		} else if (i + 1 < argc && strcmp(argv[i], "--toroids") == 0) {
+			overrides.toroidCount = atoi(argv[++i]);
+		} else if (i + 1 < argc && strcmp(argv[i], "--shots") == 0) {
+			overrides.shotCount = atoi(argv[++i]);
+		} else if (i + 1 < argc && strcmp(argv[i], "--speed") == 0) {
+			overrides.toroidSpeed = static_cast<float>(atof(argv[++i]));
+		} else if (i + 1 < argc && strcmp(argv[i], "--density") == 0) {
+			overrides.density = static_cast<float>(atof(argv[++i]));
+		} else if (argv[i][0] != '-') {
+			sceneName = argv[i];
+		} else {
+			std::cerr << "ERROR: sȃIvV'" << argv[i] << "'" << std::endl;
+			return 1;
+		}
+	}
+
+	static const char* const indirectModeName[] = { "none", "loop", "multidraw" };
+	printf("{\n  \"benchmark\": \"EntityBench\",\n  \"instancing\": %s,\n  \"indirect\": \"%s\",\n  \"textureArray\": %s,\n  \"scenes\": [",
+		useInstancing ? "true" : "false", indirectModeName[static_cast<int>(indirectMode)], useTextureArray ? "true" : "false");
+	bool isFirst = true;
+	for (SceneParameter param : sceneList) {
+		if (sceneName && strcmp(sceneName, param.name) != 0) {
+			continue;
+		}
+		if (overrides.frames >= 0) param.frames = overrides.frames;
+		if (overrides.toroidCount >= 0) param.toroidCount = overrides.toroidCount;
+		if (overrides.shotCount >= 0) param.shotCount = overrides.shotCount;
+		if (overrides.toroidSpeed >= 0) param.toroidSpeed = overrides.toroidSpeed;
+		if (overrides.density >= 0) param.density = overrides.density;
+
+		const SceneResult r = RunScene(param, useInstancing, indirectMode, useTextureArray);
+		const double frames = std::max(param.frames, 1);
+		printf("%s\n    {\n", isFirst ? "" : ",");
+		printf("      \"name\": \"%s\",\n", param.name);
+		printf("      \"toroids\": %d, \"shots\": %d, \"toroidSpeed\": %.2f, \"shotSpeed\": %.2f, \"density\": %.3f, \"frames\": %d, \"maxEntityCount\": %d,\n",
+			param.toroidCount, param.shotCount, param.toroidSpeed, param.shotSpeed, param.density, param.frames, param.maxEntityCount);
+		printf("      \"entitiesPerFrame\": %.1f,\n", r.entityCount / frames);
+		printf("      \"integrationNsPerEntity\": %.2f,\n", NanosecondsPerEntity(r.integrationTime, r.entityCount));
+		printf("      \"collisionNsPerEntity\": %.2f,\n", NanosecondsPerEntity(r.collisionTime, r.entityCount));
+		printf("      \"cullingNsPerEntity\": %.2f,\n", NanosecondsPerEntity(r.cullingTime, r.entityCount));
+		printf("      \"visiblePerFrame\": %.1f, \"culledPerFrame\": %.1f,\n", r.visibleCount / frames, r.culledCount / frames);
+		printf("      \"uploadNsPerEntity\": %.2f,\n", NanosecondsPerEntity(r.uploadTime, r.entityCount));
+		printf("      \"uploadBytesPerFrame\": %.0f,\n", r.uploadBytes / frames);
+		printf("      \"sortNsPerEntity\": %.2f,\n", NanosecondsPerEntity(r.sortTime, r.entityCount));
+		printf("      \"drawNsPerEntity\": %.2f, \"drawUsPerFrame\": %.2f,\n",
+			NanosecondsPerEntity(r.drawTime, r.entityCount), r.drawTime * 1.0e6 / frames);
+		printf("      \"drawsPerFrame\": %.1f, \"batchesPerFrame\": %.1f,\n",
+			r.drawStats.drawCount / frames, r.drawStats.batchCount / frames);
+		printf("      \"drawCallsPerFrame\": %.1f, \"drawCallsWithoutInstancingPerFrame\": %.1f,\n",
+			r.drawStats.drawCallCount / frames, r.drawStats.drawCallCountWithoutInstancing / frames);
+		printf("      \"indirectCommandsPerFrame\": %.1f,\n", r.drawStats.indirectCommandCount / frames);
+		printf("      \"programBindsPerFrame\": %.1f, \"programSkipsPerFrame\": %.1f,\n",
+			r.drawStats.programBindCount / frames, r.drawStats.programSkipCount / frames);
+		printf("      \"textureBindsPerFrame\": %.1f, \"textureSkipsPerFrame\": %.1f,\n",
+			r.drawStats.textureBindCount / frames, r.drawStats.textureSkipCount / frames);
+		printf("      \"trianglesPerFrame\": %.0f, \"lodReducedPerFrame\": %.1f,\n",
+			r.drawStats.triangleCount / frames, r.lodReducedCount / frames);
+		printf("      \"collisionTests\": %llu,\n", static_cast<unsigned long long>(r.collisionTestCount));
+		printf("      \"handlerCalls\": %llu,\n", static_cast<unsigned long long>(r.handlerCallCount));
+		printf("      \"spawnSkips\": %llu\n", static_cast<unsigned long long>(r.spawnSkipCount));
+		printf("    }");
+		isFirst = false;
+	}
+	printf("\n  ]\n}\n");
+	return 0;
+}
@@ -0,0 +1,11 @@
+#version 410
+
+layout(location=0) in vec3 inDirection;
+
+out vec4 fragColor;
+
+uniform samplerCube cubeMapSampler;
+
+void main() {
+	fragColor = texture(cubeMapSampler, inDirection);
+}
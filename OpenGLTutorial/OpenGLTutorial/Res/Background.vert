@@ -0,0 +1,15 @@
+#version 410
+
+layout(location=0) in vec3 vPosition;
+
+layout(location=0) out vec3 outDirection;
+
+// NbvWL[u}bv̕ɕϊs.
+uniform mat4 matClipToCube;
+
+void main() {
+	// Nbvʏ̓_͉ʏŐ`ɕԂ̂ŁA_ŕ߂ĕԂ΂悢.
+	vec4 direction = matClipToCube * vec4(vPosition.xy, 1, 1);
+	outDirection = direction.xyz / direction.w;
+	gl_Position = vec4(vPosition.xy, 1, 1);
+}
@@ -1,4 +1,9 @@
 #version 410
+// _[Otאڂ|XgGtFNg1̃VF[_ɂ܂Ƃ߂悤ɁAʂƂɃ}NŗLɂ.
+// ʂ͎̏ԂœKp(GameEnginepostEffectListorderƈv邱).
+//   COLOR_MATRIX: Fϊs|.
+//   POSTERIZE:    K炷.
+// ǂ`ĂȂ΁A͂̂܂܏o͂.
 
 layout(location=0) in vec2 inTexCoord;
 
@@ -13,5 +18,11 @@ layout(std140) uniform PostEffectData {
 
 void main() {
 	fragColor = texture(colorSampler, inTexCoord);
+#ifdef COLOR_MATRIX
 	fragColor.rgb = (postEffect.matColor * vec4(fragColor.rgb, 1)).rgb;
+#endif
+#ifdef POSTERIZE
+	const float numShades = 3; // e̒i.
+	fragColor.rgb = ceil(fragColor.rgb * numShades) * (1 / numShades);
+#endif
 }
\ No newline at end of file
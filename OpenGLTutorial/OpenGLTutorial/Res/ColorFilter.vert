@@ -5,7 +5,10 @@ layout(location=2) in vec2 vTexCoord;
 
 layout(location=0) out vec2 outTexCoord;
 
+// ̓eNX`̍̈ꕔɕ`悳Ăꍇ́AeNX`W̊g嗦.
+uniform vec2 texCoordScale = vec2(1);
+
 void main() {
-	outTexCoord = vTexCoord;
+	outTexCoord = vTexCoord * texCoordScale;
 	gl_Position = vec4(vPosition, 1);
 }
\ No newline at end of file
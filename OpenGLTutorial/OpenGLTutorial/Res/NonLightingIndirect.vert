@@ -0,0 +1,71 @@
+#version 410
+#extension GL_ARB_shading_language_packing : require // unpackSnorm2x16, unpackHalf2x16  GLSL 4.20 .
+#extension GL_ARB_shader_storage_buffer_object : require
+
+layout(location=0) in vec3 vPosition;
+layout(location=1) in vec4 vColor;
+layout(location=2) in vec2 vTexCoord;
+layout(location=5) in uint vDrawIndex; // `CfbNX(baseInstance + CX^Xԍ).
+
+layout(location=0) out vec4 outColor;
+layout(location=1) out vec2 outTexCoord;
+#ifdef TEXTURE_ARRAY
+layout(location=6) flat out uvec2 outLayer; // eNX`z̑w(x: J[, y: m[}}bv).
+#endif
+
+/**
+* _VF[_(1CX^X).
+*/
+struct InstanceData {
+	vec3 position; // W.
+	uint scale; // 傫XY(x_2l߂).
+	uvec2 rotation; // ](NH[^jIxyzwsnorm16ŋl߂).
+	uint color; // F(RGBA8).
+	uint layer; // 16rbg̓J[eNX`z̑wA16rbg͑傫Z(x_).
+};
+
+/**
+* GeBeBƂ̃p[^. VF[_ŕ`悷GeBeBł.
+*/
+layout(std430) readonly buffer VertexData {
+	InstanceData instance[];
+} vertexData;
+
+/**
+* `CfbNXƂ̃p[^.
+* vertexData̗vfԍ.
+*/
+layout(std430) readonly buffer DrawData {
+	uint draw[];
+} drawData;
+
+/**
+* t[Ƃ̃p[^.
+*/
+layout(std140) uniform FrameData {
+	mat4 matView;
+	mat4 matProj;
+	mat4 matVP;
+	float time;
+	float deltaTime;
+} frameData;
+
+/**
+* NH[^jIŃxNg].
+*/
+vec3 Rotate(vec4 q, vec3 v) {
+	return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+void main() {
+	InstanceData data = vertexData.instance[drawData.draw[vDrawIndex]];
+	outColor = vColor * unpackUnorm4x8(data.color);
+	outTexCoord = vTexCoord;
+#ifdef TEXTURE_ARRAY
+	outLayer = uvec2(data.layer & 0xffffu, 0u); // m[}}bv͎gȂ.
+#endif
+	vec4 rotation = vec4(unpackSnorm2x16(data.rotation.x), unpackSnorm2x16(data.rotation.y));
+	vec3 scale = vec3(unpackHalf2x16(data.scale), unpackHalf2x16(data.layer >> 16).x);
+	vec3 worldPosition = Rotate(rotation, vPosition * scale) + data.position;
+	gl_Position = frameData.matVP * vec4(worldPosition, 1.0);
+}
\ No newline at end of file
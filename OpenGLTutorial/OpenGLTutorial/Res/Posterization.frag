@@ -1,14 +0,0 @@
-#version 410
-
-layout(location=0) in vec2 inTexCoord;
-
-out vec4 fragColor;
-
-uniform sampler2D colorSampler;
-
-void main() {
-	fragColor = texture(colorSampler, inTexCoord);
-
-	const float numShades = 3; // e̒i.
-	fragColor.rgb = ceil(fragColor.rgb * numShades) * (1 / numShades);
-}
\ No newline at end of file
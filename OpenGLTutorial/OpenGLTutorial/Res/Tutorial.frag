@@ -1,41 +1,84 @@
 #version 410
+// ȉ̃}NShader::Program::Create#version̒ɒ`.
+// UNLIT         CeBOs킸AJ[eNX`g.
+// NO_NORMAL_MAP m[}}bvg킸A_̖@ŃCeBO.
+// TEXTURE_ARRAY eNX`z񂩂A_VF[_nwǂݎ.
 
 layout(location=0) in vec4 inColor;
 layout(location=1) in vec2 inTexCoord;
+#ifndef UNLIT
 layout(location=2) in vec3 inWorldPosition;
+#ifdef NO_NORMAL_MAP
+layout(location=3) in vec3 inNormal;//@([hWn).
+#else
 layout(location=3) in mat3 inTBN;//ڋԍs.
+#endif
+#endif
 
 out vec4 fragColor;
 // 0ԖڂɃJ[eNX`A1Ԃ߂Ƀm[}}bveNX`n邱Ƃz.
+#ifdef TEXTURE_ARRAY
+layout(location=6) flat in uvec2 inLayer; // eNX`z̑w(x: J[, y: m[}}bv).
+uniform sampler2DArray colorSampler[2];
+#define SampleTexture(i, uv) texture(colorSampler[i], vec3(uv, float(inLayer[i])))
+#else
 uniform sampler2D colorSampler[2];
+#define SampleTexture(i, uv) texture(colorSampler[i], uv)
+#endif
 
+#ifndef UNLIT
 // Cgf[^(_).
 struct PointLight {
-	vec4 position; //W([hWn).
+	vec4 position; // xyz: W([hWn). w: e͈.
 	vec4 color; // 邳.
 }; 
  
-const int maxLightCount = 4; // Cg̐. 
+const int maxLightCount = 256; // Cg̍ő吔.
  
 // CeBOp[^.
 layout(std140) uniform LightData {
 	vec4 ambientColor; // .
+	vec4 tileScale; // xy: ʍW^CԍɕϊW. zw: [x̑ΐXCXԍɕϊWƒ萔.
+	vec4 depthParams; // [xobt@̒lr[Wn̐[xɕϊW(near*far, far, far-near, gp).
+	uvec4 clusterCount; // xyz: Əc̃^CAXCX.
 	PointLight light[maxLightCount]; // Cg̃Xg.
 } lightData;
 
+// NX^Ƃ̃Cg͈̔(x: lightIndexSampler̊Jnʒu, y: Cg).
+uniform usamplerBuffer lightGridSampler;
+// NX^Ɋ܂܂郉Cg̔ԍ.
+uniform usamplerBuffer lightIndexSampler;
+#endif
 
 void main() {
+	fragColor = inColor * SampleTexture(0, inTexCoord);//J[eNX`̎擾.
+#ifndef UNLIT
+#ifdef NO_NORMAL_MAP
+	vec3 normal = normalize(inNormal);
+#else
 	// m[}}bveNX`ǂݎAtڃxNgԍs|Ė@[hWnɕϊ.
-	vec3 normal =texture(colorSampler[1], inTexCoord).xyz * 2.0 - 1.0;
+	vec3 normal =SampleTexture(1, inTexCoord).xyz * 2.0 - 1.0;
 	normal = inTBN * normal;
+#endif
+
+	// ʏ̃^Cƃr[Wn̐[xÃtOgNX^߂.
+	uvec2 tile = min(uvec2(gl_FragCoord.xy * lightData.tileScale.xy), lightData.clusterCount.xy - 1u);
+	float viewDepth = lightData.depthParams.x / (lightData.depthParams.y - gl_FragCoord.z * lightData.depthParams.z);
+	uint slice = uint(clamp(log(viewDepth) * lightData.tileScale.z + lightData.tileScale.w, 0.0, float(lightData.clusterCount.z - 1u)));
+	int cluster = int((slice * lightData.clusterCount.y + tile.y) * lightData.clusterCount.x + tile.x);
+	uvec2 lightRange = texelFetch(lightGridSampler, cluster).xy;
 
 	vec3 lightColor = lightData.ambientColor.rgb;
-	for (int i = 0; i < maxLightCount; ++i) {
-		vec3 lightVector = lightData.light[i].position.xyz - inWorldPosition; 
-		float lightPower = 1.0 / dot(lightVector, lightVector);
+	for (uint i = 0u; i < lightRange.y; ++i) {
+		PointLight light = lightData.light[texelFetch(lightIndexSampler, int(lightRange.x + i)).x];
+		vec3 lightVector = light.position.xyz - inWorldPosition; 
+		float distanceSq = dot(lightVector, lightVector);
+		// t2̌ɁAe͈͂0ɂȂ鑋֐|.
+		float window = clamp(1.0 - distanceSq / (light.position.w * light.position.w), 0, 1);
+		float lightPower = window * window / distanceSq;
 		float cosTheta = clamp(dot(normal, normalize(lightVector)), 0, 1);
-		lightColor += lightData.light[i].color.rgb * cosTheta * lightPower;
+		lightColor += light.color.rgb * cosTheta * lightPower;
 	}
-	fragColor = inColor * texture(colorSampler[0], inTexCoord);//J[eNX`̎擾.
 	fragColor.rgb *= lightColor;
+#endif
 }
\ No newline at end of file
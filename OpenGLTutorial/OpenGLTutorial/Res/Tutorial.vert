@@ -9,33 +9,68 @@ layout(location=4) in vec4 vTangent;//
 layout(location=0) out vec4 outColor;
 layout(location=1) out vec2 outTexCoord;
 layout(location=2) out vec3 outWorldPosition;
+#ifdef NO_NORMAL_MAP
+layout(location=3) out vec3 outNormal;//@([hWn).
+#else
 // ڃxNg(Tangent)A]@xNg(Binormal)A@xNg(Normal).
 layout(location=3) out mat3 outTBN;//ڋԍs.
+#endif
+#ifdef TEXTURE_ARRAY
+layout(location=6) flat out uvec2 outLayer; // eNX`z̑w(x: J[, y: m[}}bv).
+#endif
 
 /**
 * _VF[_̃p[^.
 */
 layout(std140) uniform VertexData {
-	mat4 matMVP;
-	mat4 matModel;
-	mat3x4 matNormal;
-	vec4 color;
+	vec3 position; // W.
+	uint color; // F(RGBA8).
+	vec4 rotation; // ](NH[^jI).
+	vec3 scale; // 傫.
+	uint layer; // eNX`z̑w(16rbg̓J[A16rbg̓m[}}bv).
 } vertexData;
 
+/**
+* t[Ƃ̃p[^.
+*/
+layout(std140) uniform FrameData {
+	mat4 matView;
+	mat4 matProj;
+	mat4 matVP;
+	float time;
+	float deltaTime;
+} frameData;
+
+/**
+* NH[^jIŃxNg].
+*/
+vec3 Rotate(vec4 q, vec3 v) {
+	return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
 
 void main() {
 
-	outColor = vColor * vertexData.color;
+	outColor = vColor * unpackUnorm4x8(vertexData.color);
 	outTexCoord = vTexCoord;
-	outWorldPosition = (vertexData.matModel * vec4(vPosition, 1.0)).xyz;
+#ifdef TEXTURE_ARRAY
+	outLayer = uvec2(vertexData.layer & 0xffffu, vertexData.layer >> 16);
+#endif
+	// gE]Eړ̏ɕϊă[hWnɕϊ.
+	outWorldPosition = Rotate(vertexData.rotation, vPosition * vertexData.scale) + vertexData.position;
 
-	// ڋԂ\3̃xNgɉ]s|ă[hWnɕϊ.
-	mat3 matNormal = mat3(vertexData.matNormal);
-	vec3 t = matNormal * vTangent.xyz;
-	vec3 n = matNormal * vNormal;
-	vec3 b = normalize(cross(n, t)) * vTangent.w;
+#ifdef NO_NORMAL_MAP
+	// m[}}bvgȂꍇ͖@].
+	outNormal = Rotate(vertexData.rotation, vNormal);
+#else
+	// ڋԂ\3̃xNg]ă[hWnɕϊ.
+	// k_f[^ł͒1ɂȂȂ̂ŐK.
+	// ]@̌́Aw-1-1/3ɕϊ邽ߕg.
+	vec3 t = Rotate(vertexData.rotation, normalize(vTangent.xyz));
+	vec3 n = Rotate(vertexData.rotation, normalize(vNormal));
+	vec3 b = normalize(cross(n, t)) * (vTangent.w < 0.0 ? -1.0 : 1.0);
 	// 3x3sɓ]uċts쐬.
 	outTBN = mat3(t, b, n);
+#endif
 
-	gl_Position = vertexData.matMVP * vec4(vPosition, 1.0);
+	gl_Position = frameData.matVP * vec4(outWorldPosition, 1.0);
 }
\ No newline at end of file
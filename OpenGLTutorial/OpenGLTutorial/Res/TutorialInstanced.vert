@@ -0,0 +1,86 @@
+#version 410
+
+layout(location=0) in vec3 vPosition;
+layout(location=1) in vec4 vColor;
+layout(location=2) in vec2 vTexCoord;
+layout(location=3) in vec3 vNormal;
+layout(location=4) in vec4 vTangent;//ڃxNg.
+
+layout(location=0) out vec4 outColor;
+layout(location=1) out vec2 outTexCoord;
+layout(location=2) out vec3 outWorldPosition;
+#ifdef NO_NORMAL_MAP
+layout(location=3) out vec3 outNormal;//@([hWn).
+#else
+// ڃxNg(Tangent)A]@xNg(Binormal)A@xNg(Normal).
+layout(location=3) out mat3 outTBN;//ڋԍs.
+#endif
+#ifdef TEXTURE_ARRAY
+layout(location=6) flat out uvec2 outLayer; // eNX`z̑w(x: J[, y: m[}}bv).
+#endif
+
+/**
+* _VF[_̃p[^(1CX^X).
+*/
+struct InstanceData {
+	vec3 position; // W.
+	uint color; // F(RGBA8).
+	vec4 rotation; // ](NH[^jI).
+	vec3 scale; // 傫.
+	uint layer; // eNX`z̑w(16rbg̓J[A16rbg̓m[}}bv).
+};
+
+const int maxInstanceCount = 64; // Uniform::maxInstanceCount Ɠlɂ邱.
+
+/**
+* _VF[_̃p[^. gl_InstanceIDԖڂ̗vfg.
+*/
+layout(std140) uniform VertexData {
+	InstanceData instance[maxInstanceCount];
+} vertexData;
+
+/**
+* t[Ƃ̃p[^.
+*/
+layout(std140) uniform FrameData {
+	mat4 matView;
+	mat4 matProj;
+	mat4 matVP;
+	float time;
+	float deltaTime;
+} frameData;
+
+/**
+* NH[^jIŃxNg].
+*/
+vec3 Rotate(vec4 q, vec3 v) {
+	return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+void main() {
+	InstanceData data = vertexData.instance[gl_InstanceID];
+
+	outColor = vColor * unpackUnorm4x8(data.color);
+	outTexCoord = vTexCoord;
+#ifdef TEXTURE_ARRAY
+	outLayer = uvec2(data.layer & 0xffffu, data.layer >> 16);
+#endif
+	// gE]Eړ̏ɕϊă[hWnɕϊ.
+	outWorldPosition = Rotate(data.rotation, vPosition * data.scale) + data.position;
+
+#ifdef NO_NORMAL_MAP
+	// m[}}bvgȂꍇ͖@].
+	outNormal = Rotate(data.rotation, vNormal);
+#else
+	// ڋԂ\3̃xNg]ă[hWnɕϊ.
+	// k_f[^ł͒1ɂȂȂ̂ŐK.
+	// ]@̌́Aw-1-1/3ɕϊ邽ߕg.
+	vec3 t = Rotate(data.rotation, normalize(vTangent.xyz));
+	vec3 n = Rotate(data.rotation, normalize(vNormal));
+	vec3 b = normalize(cross(n, t)) * (vTangent.w < 0.0 ? -1.0 : 1.0);
+	// 3x3sɓ]uċts쐬.
+	outTBN = mat3(t, b, n);
+#endif
+
+	gl_Position = frameData.matVP * vec4(outWorldPosition, 1.0);
+}
\ No newline at end of file
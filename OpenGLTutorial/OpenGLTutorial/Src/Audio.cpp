@@ -135,6 +135,9 @@ namespace Audio {
 	* @param cueId    ĐL[ID.
 	*/
 	void Play(int playerId, int cueId){
+		if (!player[playerId]) {
+			return; // I[fBIĂȂ.
+		}
 		// vC[ɃL[蓖.
 		criAtomExPlayer_SetCueId(player[playerId], acb, cueId);
 		// ĐJn.
@@ -147,6 +150,9 @@ namespace Audio {
 	* @param playerId Đ~vC[ID.
 	*/
 	void Stop(int playerId){
+		if (!player[playerId]) {
+			return;
+		}
 		// Đ~.
 		criAtomExPlayer_Stop(player[playerId]);
 	}
@@ -3,6 +3,7 @@
 */
 
 #include "BufferObject.h"
+#include "GLState.h"
 
 /**
 * obt@IuWFNg쐬.
@@ -18,6 +19,7 @@ void BufferObject::Init(GLenum target, GLsizeiptr size, const GLvoid* data, GLen
 	glBindBuffer(target, id);
 	glBufferData(target, size, data, usage);
 	glBindBuffer(target, 0);
+	this->size = size;
 }
 
 /**
@@ -27,9 +29,67 @@ void BufferObject::Destroy(){
 	if (id) {
 		glDeleteBuffers(1, &id);
 		id = 0;
+		size = 0;
 	}
 }
 
+/**
+* obt@̐擪w肳ꂽoCgVXeɃ}bv.
+*
+* @param target }bvɎgobt@̎.
+* @param size   }bvoCg.
+*
+* @return }bvւ̃|C^.
+*
+* ȑO̓e͔j邽߁AݐpƂĎg.
+*/
+void* BufferObject::MapBuffer(GLenum target, GLsizeiptr size) const{
+	glBindBuffer(target, id);
+	return glMapBufferRange(target, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+}
+
+/**
+* obt@̊蓖Ă.
+*
+* @param target MapBuffer Ɏw肵obt@̎.
+*/
+void BufferObject::UnmapBuffer(GLenum target) const{
+	glBindBuffer(target, id);
+	glUnmapBuffer(target);
+}
+
+/**
+* w肳ꂽ͈͂oCfBOE|CgɊ蓖Ă.
+*
+* @param target 蓖Đ̎(GL_SHADER_STORAGE_BUFFER Ȃ).
+* @param index  蓖Đ̃oCfBOE|Cg.
+* @param offset 蓖Ă͈͂̃oCgItZbg.
+* @param size   蓖Ă͈͂̃oCg.
+*/
+void BufferObject::BindBufferRange(GLenum target, GLuint index, GLintptr offset, GLsizeiptr size) const{
+	GLState::BindBufferRange(target, index, id, offset, size);
+}
+
+/**
+* GL_SHADER_STORAGE_BUFFER  BindBufferRange ɎwłItZbg̋E擾.
+*
+* @return ItZbg͂̒l̔{łȂ΂ȂȂ.
+*
+* SSBOɑΉĂȂł́AG[NȂ悤ɖ₢킹ɊlԂ.
+*/
+GLintptr BufferObject::StorageOffsetAlignment(){
+	static GLint alignment = 0;
+	if (!alignment) {
+		if (GLEW_VERSION_4_3 || GLEW_ARB_shader_storage_buffer_object) {
+			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		}
+		if (alignment <= 0) {
+			alignment = 256; // 擾łȂ΁Am̎ōő̒lg.
+		}
+	}
+	return alignment;
+}
+
 /**
 * VAO쐬.
 *
@@ -39,10 +99,10 @@ void BufferObject::Destroy(){
 void VertexArrayObject::Init(GLuint vbo, GLuint ibo){
 	Destroy();
 	glGenVertexArrays(1, &id);
-	glBindVertexArray(id);
+	GLState::BindVertexArray(id);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-	glBindVertexArray(0);
+	GLState::BindVertexArray(0);
 }
 
 /**
@@ -50,6 +110,8 @@ void VertexArrayObject::Init(GLuint vbo, GLuint ibo){
 */
 void VertexArrayObject::Destroy(){
 	if (id) {
+		// 폜IDėpꂽƂɊ蓖čς݂Ɣ肳Ȃ悤AL^Ă.
+		GLState::BindVertexArray(0);
 		glDeleteVertexArrays(1, &id);
 		id = 0;
 	}
@@ -77,12 +139,12 @@ void VertexArrayObject::VertexAttribPointer(GLuint index, GLint size, GLenum typ
 * VAOΏۂɂ.
 */
 void VertexArrayObject::Bind() const {
-	glBindVertexArray(id);
+	GLState::BindVertexArray(id);
 }
 
 /**
 * VAOΏۂO.
 */
 void VertexArrayObject::Unbind() const {
-	glBindVertexArray(0);
+	GLState::BindVertexArray(0);
 }
\ No newline at end of file
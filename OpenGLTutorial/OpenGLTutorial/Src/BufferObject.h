@@ -19,8 +19,14 @@ public:
 	void Init(GLenum target, GLsizeiptr size, const GLvoid* data = nullptr, GLenum usage = GL_STATIC_DRAW);
 	void Destroy();
 	GLuint Id() const { return id; }
+	GLsizeiptr Size() const { return size; }
+	void* MapBuffer(GLenum target, GLsizeiptr size) const;
+	void UnmapBuffer(GLenum target) const;
+	void BindBufferRange(GLenum target, GLuint index, GLintptr offset, GLsizeiptr size) const;
+	static GLintptr StorageOffsetAlignment();
 private:
 	GLuint id = 0;
+	GLsizeiptr size = 0;
 };
 
 /**
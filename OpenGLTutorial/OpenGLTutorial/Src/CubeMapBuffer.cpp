@@ -0,0 +1,87 @@
+/**
+* @file CubeMapBuffer.cpp
+*/
+#include "CubeMapBuffer.h"
+#include "GLState.h"
+#include <iostream>
+
+/**
+* L[u}bṽItXN[obt@쐬.
+*
+* @param size 1ʂ̕ƍ(sNZP).
+*
+* @return 쐬ItXN[obt@ւ̃|C^.
+*/
+CubeMapBufferPtr CubeMapBuffer::Create(int size){
+	struct Impl : CubeMapBuffer {
+		Impl() {};	// RXgN^
+		~Impl() {};	// fXgN^
+	};
+	CubeMapBufferPtr cubeMap = std::make_shared<Impl>();
+
+	if (!cubeMap) {
+		return cubeMap;
+	}
+	cubeMap->size = size;
+
+	// 6ʂ̃eNX`쐬. ʂ̋EŐFȂ悤ɁAV[XȃtB^Lɂ.
+	glGenTextures(1, &cubeMap->texture);
+	GLState::BindTexture(0, GL_TEXTURE_CUBE_MAP, cubeMap->texture);
+	for (int i = 0; i < 6; ++i) {
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	GLState::Enable(GL_TEXTURE_CUBE_MAP_SEAMLESS, true);
+
+	// [xobt@̍쐬
+	glGenRenderbuffers(1, &cubeMap->depthbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, cubeMap->depthbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	// `悷ʂBindFaceŊ蓖Ă.
+	glGenFramebuffers(1, &cubeMap->framebuffer);
+	GLState::BindFramebuffer(cubeMap->framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, cubeMap->depthbuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X, cubeMap->texture, 0);
+	const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	GLState::BindFramebuffer(0);
+	if (status != GL_FRAMEBUFFER_COMPLETE) {
+		std::cerr << "ERROR: L[u}bṽt[obt@̍쐬Ɏs(status=" << status << ")" << std::endl;
+		return {};
+	}
+	return cubeMap;
+}
+
+/**
+* L[u}bv̖ʂ`ɐݒ肷.
+*
+* @param face `悷(0`5. GL_TEXTURE_CUBE_MAP_POSITIVE_X ̏).
+*
+* t[obt@Ar[|[gAVU[`ʑŜɐݒ肷.
+*/
+void CubeMapBuffer::BindFace(int face) const{
+	GLState::BindFramebuffer(framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, texture, 0);
+	GLState::Viewport(0, 0, size, size);
+	GLState::Scissor(0, 0, size, size);
+}
+
+/**
+* fXgN^.
+*/
+CubeMapBuffer::~CubeMapBuffer(){
+	if (framebuffer) {
+		glDeleteFramebuffers(1, &framebuffer);
+	}
+	if (depthbuffer) {
+		glDeleteRenderbuffers(1, &depthbuffer);
+	}
+	if (texture) {
+		glDeleteTextures(1, &texture);
+	}
+}
@@ -0,0 +1,35 @@
+/**
+* @file CubeMapBuffer.h
+*/
+#ifndef CUBEMAPBUFFER_H_INCLUDED
+#define CUBEMAPBUFFER_H_INCLUDED
+#include <GL/glew.h>
+#include <memory>
+
+class CubeMapBuffer;
+typedef std::shared_ptr<CubeMapBuffer> CubeMapBufferPtr;
+
+/**
+* L[u}bv̊eʂɕ`悷邽߂̃ItXN[obt@.
+*/
+class CubeMapBuffer{
+public:
+	static CubeMapBufferPtr Create(int size);
+	void BindFace(int face) const;
+	GLuint GetTexture() const { return texture; } ///< L[u}bvEeNX`擾.
+	int Size() const { return size; } ///< 1ʂ̕ƍ擾.
+
+private:
+	CubeMapBuffer() = default;
+	CubeMapBuffer(const CubeMapBuffer&) = delete;
+	CubeMapBuffer& operator=(const CubeMapBuffer&) = delete;
+	~CubeMapBuffer();
+
+private:
+	int size = 0; ///< 1ʂ̕ƍ.
+	GLuint texture = 0; ///< L[u}bvEeNX`.
+	GLuint depthbuffer = 0; ///< eʂŋL[xobt@IuWFNg.
+	GLuint framebuffer = 0; ///< t[obt@IuWFNg.
+};
+
+#endif // CUBEMAPBUFFER_H_INCLUDED
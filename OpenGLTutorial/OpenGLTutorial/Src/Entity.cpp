@@ -3,30 +3,214 @@
 */
 #include "Entity.h"
 #include "Uniform.h"
+#include "GLState.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 #include <iostream>
+#include <chrono>
+#include <string.h>
 #include <algorithm>// ܂܂ȃASYC++Ŏ֐֐IuWFNg`Ăwb_
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#include <xmmintrin.h>
+#define ENTITY_CULLING_USE_SSE
+#endif
 
 /**
 * GeBeBɊւR[hi[閼O.
 */
 namespace Entity {
+
+	/**
+	* GeBeB̃eNX`z̑wl߂.
+	*
+	* @param entity w擾GeBeB.
+	*
+	* @return 16rbgɃJ[A16rbgɃm[}}bv̑wi[l.
+	*         eNX`z̑włȂeNX`0ɂȂ.
+	*/
+	glm::uint32 PackLayer(const Entity& entity){
+		const TexturePtr& color = entity.GetTexture(0);
+		const TexturePtr& normal = entity.GetTexture(1);
+		return (color ? static_cast<glm::uint32>(color->Layer()) & 0xffff : 0) |
+			(normal ? static_cast<glm::uint32>(normal->Layer()) << 16 : 0);
+	}
+
+	/**
+	* GeBeB̏ԂVertexDataɕϊ.
+	*
+	* @param entity ϊGeBeB.
+	* @param data   ϊ̃f[^.
+	*
+	* švZ͒_VF[_ōs߁AWA]A傫AF].
+	* r[EvWFNVs̓t[Ƃ Uniform::FrameData œ].
+	*/
+	void PayloadTraits<Uniform::VertexData>::Pack(const Entity& entity, Uniform::VertexData& data){
+		data.position = entity.Position();
+		data.color = glm::packUnorm4x8(entity.Color());
+		const glm::quat& q = entity.Rotation();
+		data.rotation = glm::vec4(q.x, q.y, q.z, q.w);
+		data.scale = entity.Scale();
+		data.layer = PackLayer(entity);
+	}
+
+	/**
+	* -1`12̒lsnorm16ɗʎqċl߂.
+	*
+	* @param a 16rbgɊi[l.
+	* @param b 16rbgɊi[l.
+	*
+	* @return GLSLunpackSnorm2x16ŕłl.
+	*
+	* KꂽNH[^jIpȂ̂Ŕ͈͊O̒l̐؂l߂ȗA
+	* ۂ߂͐؂̂Ăōs(glm::packSnorm2x16̊ۂߊ֐Ăяo邽).
+	*/
+	glm::uint32 PackSnorm2x16(float a, float b){
+		const int ia = static_cast<int>(a * 32767.0f + (a < 0 ? -0.5f : 0.5f));
+		const int ib = static_cast<int>(b * 32767.0f + (b < 0 ? -0.5f : 0.5f));
+		return (static_cast<glm::uint32>(ia) & 0xffff) | (static_cast<glm::uint32>(ib) << 16);
+	}
+
+	/**
+	* GeBeB̏ԂCompactVertexDataɕϊ.
+	*
+	* @param entity ϊGeBeB.
+	* @param data   ϊ̃f[^.
+	*
+	* 傫͔x_ɋl߂̂ŁAeقȂ傫\.
+	* ̃yC[hgVF[_͏Ɩg킸m[}}bv̑wsvȂ̂ŁȀꏊɑ傫Zl߂.
+	*/
+	void PayloadTraits<Uniform::CompactVertexData>::Pack(const Entity& entity, Uniform::CompactVertexData& data){
+		const glm::vec3& scale = entity.Scale();
+		data.position = entity.Position();
+		data.scale = glm::packHalf2x16(glm::vec2(scale.x, scale.y));
+		const glm::quat& q = entity.Rotation();
+		data.rotation[0] = PackSnorm2x16(q.x, q.y);
+		data.rotation[1] = PackSnorm2x16(q.z, q.w);
+		data.color = glm::packUnorm4x8(entity.Color());
+		data.layer = (PackLayer(entity) & 0xffff) | (glm::packHalf2x16(glm::vec2(scale.z, 0)) << 16);
+	}
+
+	/**
+	* `PʂŊ蓖ĂeNX`擾.
+	*
+	* @param texture GeBeB̃eNX`.
+	*
+	* @return eNX`z̑wȂw܂ރeNX`zAłȂ texture.
+	*
+	* eNX`z̑wgGeBeB́AwĂ`Pʂɂ܂Ƃ߂.
+	* w̔ԍ̓yC[hŒ_VF[_ɓn.
+	*/
+	const Texture* BindingTexture(const TexturePtr& texture){
+		return texture->Array() ? texture->Array().get() : texture.get();
+	}
+
+	/// בւL[Ő[xʂł͈(r[Wn̋).
+	static const float sortDepthRange = 256.0f;
+	/// בւL[ŕ`L[i[rbgʒu.
+	static const int sortQueueShift = 62;
+
+	/**
+	* `L[̕בւL[쐬.
+	*
+	* @param queue   `L[.
+	* @param program VF[_vOID.
+	* @param tex0    J[eNX`ID.
+	* @param tex1    m[}}bveNX`ID.
+	* @param mesh    bV̐擪}eÃCfbNX.
+	* @param depth   r[Wnł̎_̋.
+	*
+	* @return ŏ2rbgɕ`L[l߂64rbg̃L[. c̃rbg͕`L[ɂĈقȂ.
+	*         Opaque:      [x̋(4), VF[_(8), eNX`(10+10), bV(10), [x(20).
+	*         Background:  VF[_(8), eNX`(10+10), bV(10).
+	*         Transparent: ][x(20), VF[_(8), eNX`(10+10), bV(10).
+	*
+	* s͑܂ɎO牜ׂ֕AԂ̒ł͏Ԃ̐؂ւȂȂ悤ɕׂ.
+	* ͐uh邽߁AԂɊ֌WȂOׂ֕.
+	* ID͉ʃrbgg߁Al傫ƕʂ̂̂ƓL[ɂȂ邱Ƃ.
+	* ̏ꍇя邾ŁA`挋ʂ͕ςȂ.
+	*/
+	uint64_t MakeSortKey(RenderQueue queue, GLuint program, GLuint tex0, GLuint tex1, size_t mesh, float depth){
+		const float d = glm::clamp(depth / sortDepthRange, 0.0f, 1.0f);
+		const uint64_t quantizedDepth = static_cast<uint64_t>(d * 0xfffff);
+		const uint64_t state = (static_cast<uint64_t>(program & 0xff) << 30) |
+			(static_cast<uint64_t>(tex0 & 0x3ff) << 20) |
+			(static_cast<uint64_t>(tex1 & 0x3ff) << 10) |
+			static_cast<uint64_t>(mesh & 0x3ff);
+		const uint64_t key = static_cast<uint64_t>(queue) << sortQueueShift;
+		switch (queue) {
+		default:
+		case RenderQueue::Opaque:
+			return key | ((quantizedDepth >> 16) << 58) | (state << 20) | quantizedDepth;
+		case RenderQueue::Background:
+			return key | (state << 20);
+		case RenderQueue::Transparent:
+			return key | ((0xfffff - quantizedDepth) << 42) | (state << 4);
+		}
+	}
+
+	/**
+	* `L[ɍ킹ăuhƐ[xeXg̏Ԃݒ肷.
+	*
+	* @param queue `L[.
+	*
+	* wi͐[x͈̔͂1ɌŒ肵As񂾕ł͐[xeXgɎs.
+	*/
+	void BindQueueState(RenderQueue queue){
+		switch (queue) {
+		default:
+		case RenderQueue::Opaque:
+			GLState::Enable(GL_BLEND, false);
+			GLState::DepthMask(true);
+			GLState::DepthFunc(GL_LESS);
+			GLState::DepthRange(0, 1);
+			break;
+		case RenderQueue::Background:
+			GLState::Enable(GL_BLEND, false);
+			GLState::DepthMask(false);
+			GLState::DepthFunc(GL_LEQUAL);
+			GLState::DepthRange(1, 1);
+			break;
+		case RenderQueue::Transparent:
+			GLState::Enable(GL_BLEND, true);
+			GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			GLState::DepthMask(false);
+			GLState::DepthFunc(GL_LESS);
+			GLState::DepthRange(0, 1);
+			break;
+		}
+	}
+
 	/**
-	* VertexDataUBOɓ].
+	* 64rbg̃L[vf̔z\[gŕבւ.
 	*
-	* @param entity
-	* @param ubo
-	* @param matViewProjection
-	* @tips	 UpdateToroidVetexDataR[hx[Xcolor̐ݒǉA
-	*		 ViewsProjections܂Ƃ߂ēn悤ɂ
+	* @param v   בւz.
+	* @param tmp Ɨp̔z.
+	*
+	* 8rbg8ɕĉʂ̌\[g.
+	* ׂĂ̗vfœl͕בւȗ.
 	*/
-	void UpdateUniformVertexData(Entity& entity, void* ubo, const glm::mat4& matVP){
-		Uniform::VertexData data;
-		data.matModel = entity.TRSMatrix();
-		data.matNormal = glm::mat4_cast(entity.Rotation());
-		data.matMVP = matVP * data.matModel;
-		data.color = entity.Color();
-		memcpy(ubo, &data, sizeof(data));
+	template<typename T>
+	void RadixSort(std::vector<T>& v, std::vector<T>& tmp){
+		tmp.resize(v.size());
+		for (int shift = 0; shift < 64; shift += 8) {
+			size_t count[256] = {};
+			for (const T& e : v) {
+				++count[(e.key >> shift) & 0xff];
+			}
+			if (count[(v.front().key >> shift) & 0xff] == v.size()) {
+				continue;
+			}
+			size_t offset = 0;
+			for (size_t& n : count) {
+				const size_t tmpCount = n;
+				n = offset;
+				offset += tmpCount;
+			}
+			for (const T& e : v) {
+				tmp[count[(e.key >> shift) & 0xff]++] = e;
+			}
+			v.swap(tmp);
+		}
 	}
 
 	/**
@@ -86,17 +270,25 @@ namespace Entity {
 	* @param ubSizePerEntity  GeBeBƂUniform Buffer̃oCg.
 	* @param bindingPoint     GeBeBpUBÕoCfBO|Cg.
 	* @param ubName           GeBeBpUniform Buffer̖O.
+	* @param uboFrameCount    GeBeBpUBÕOobt@̃t[.
+	*                         2ȏ̏ꍇA` NextFrame Ăяo.
 	*
 	* @return 쐬GeBeBobt@ւ̃|C^.
 	*/
-	BufferPtr Buffer::Create(size_t maxEntityCount, GLsizeiptr ubSizePerEntity, int bindingPoint, const char* ubName){
+	BufferPtr Buffer::Create(size_t maxEntityCount, GLsizeiptr ubSizePerEntity, int bindingPoint, const char* ubName,
+		int uboFrameCount){
 		struct Impl : Buffer { Impl() {} ~Impl() {} };
 		BufferPtr p = std::make_shared<Impl>();
 		if (!p) {
 			std::cerr << "WARNING in Entity::Buffer::Create: obt@̍쐬Ɏs." << std::endl;
 			return{};
 		}
-		p->ubo = UniformBuffer::Create(maxEntityCount * ubSizePerEntity, bindingPoint, ubName);
+		// `PʂƂUBOf[^̊JnʒuEɍ킹邽߁Aň̏ꍇ͑SGeBeBꂼꋫEL.
+		// ܂ACX^X`ł͍őCX^X͈̔͂蓖Ă邽߁A̗̕]Tmۂ.
+		const GLintptr alignment = UniformBuffer::OffsetAlignment();
+		const GLsizeiptr alignedSize = (ubSizePerEntity + alignment - 1) / alignment * alignment;
+		p->ubo = UniformBuffer::Create(maxEntityCount * alignedSize + ubSizePerEntity * Uniform::maxInstanceCount,
+			bindingPoint, ubName, uboFrameCount);
 		p->buffer.reset(new LinkEntity[maxEntityCount]);
 		if (!p->ubo || !p->buffer) {
 			std::cerr << "WARNING in Entity::Buffer::Create: obt@̍쐬Ɏs." << std::endl;
@@ -104,18 +296,54 @@ namespace Entity {
 		}
 		p->bufferSize = maxEntityCount;
 		p->ubSizePerEntity = ubSizePerEntity;
-		GLintptr offset = 0;
+		p->defaultPayload = { static_cast<GLsizeiptr>(sizeof(Uniform::VertexData)), &PackPayload<Uniform::VertexData> };
+		if (p->defaultPayload.size > ubSizePerEntity) {
+			std::cerr << "WARNING in Entity::Buffer::Create: ubSizePerEntity(" << ubSizePerEntity <<
+				")VertexDatãTCY菬ł." << std::endl;
+			return{};
+		}
+		p->ubAlignment = alignment;
+		p->storageAlignment = BufferObject::StorageOffsetAlignment();
 		const LinkEntity* const end = &p->buffer[maxEntityCount];
 		for (LinkEntity* itr = &p->buffer[0]; itr != end; ++itr) {
-			itr->uboOffset = offset;
 			itr->pBuffer = p.get();
 			p->freeList.Insert(itr);
-			offset += ubSizePerEntity;
 		}
 		p->collisionHandlerList.reserve(maxGroupId);
 		return p;
 	}
 
+	/**
+	* Ԑڕ`̗LE؂ւ.
+	*
+	* @param enable Ԑڕ`LɂȂtrueAɂȂfalse.
+	*
+	* @retval true  ؂ւ.
+	* @retval false Ԑڕ`p̃obt@̍쐬Ɏs.
+	*
+	* LɂƁAԐڕ`p̃VF[_(Shader::Program::Indirect)vOŕ`悷GeBeB́A
+	* yC[hSSBOɏ݁AԐڕ`R}hŕ`悳.
+	* bVobt@Ԑڕ`ɑΉĂ(Mesh::Buffer::GetIndirectMode  None ȊO)ꍇɂLɂ邱.
+	*/
+	bool Buffer::Indirect(bool enable){
+		if (enable && !payloadStorage.Id()) {
+			const GLsizeiptr alignedSize = (ubSizePerEntity + storageAlignment - 1) / storageAlignment * storageAlignment;
+			payloadStorage.Init(GL_SHADER_STORAGE_BUFFER, bufferSize * alignedSize, nullptr, GL_DYNAMIC_DRAW);
+			drawDataStorage.Init(GL_SHADER_STORAGE_BUFFER, Mesh::maxDrawIndexCount * sizeof(Uniform::DrawData), nullptr, GL_DYNAMIC_DRAW);
+			commandBuffer.Init(GL_DRAW_INDIRECT_BUFFER, Mesh::maxDrawIndexCount * sizeof(Mesh::DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+			if (!payloadStorage.Id() || !drawDataStorage.Id() || !commandBuffer.Id()) {
+				std::cerr << "WARNING in Entity::Buffer::Indirect: Ԑڕ`pobt@̍쐬Ɏs." << std::endl;
+				payloadStorage.Destroy();
+				drawDataStorage.Destroy();
+				commandBuffer.Destroy();
+				return false;
+			}
+			commandList.reserve(Mesh::maxDrawIndexCount);
+		}
+		isIndirect = enable;
+		return true;
+	}
+
 	/**
 	* GeBeBǉ.
 	*
@@ -157,8 +385,10 @@ namespace Entity {
 		entity->mesh = mesh;
 		entity->texture[0] = t[0];
 		entity->texture[1] = t[1];
+		entity->color = glm::vec4(1, 1, 1, 1);
 		entity->program = program;
 		entity->updateFunc = func;
+		entity->queue = RenderQueue::Opaque;
 		entity->isActive = true;
 		return entity;
 	}
@@ -194,6 +424,28 @@ namespace Entity {
 		p->isActive = false;
 	}
 
+	/**
+	* vOŕ`悷GeBeB̃yC[hݒ肷.
+	*
+	* @param program yC[hݒ肷vO.
+	* @param payload ݒ肷yC[h.
+	*
+	* @retval true  ݒ萬.
+	* @retval false yC[hGeBeBƂ̍őoCgzĂ̂Őݒ肵Ȃ.
+	*/
+	bool Buffer::Payload(const Shader::ProgramPtr& program, const PayloadInfo& payload){
+		if (!program) {
+			return false;
+		}
+		if (payload.size > ubSizePerEntity) {
+			std::cerr << "ERROR in Entity::Buffer::Payload: yC[h̃TCY(" << payload.size <<
+				")GeBeBƂ̍őoCg(" << ubSizePerEntity << ")zĂ܂." << std::endl;
+			return false;
+		}
+		payloadMap[program.get()] = payload;
+		return true;
+	}
+
 	/**
 	* `m̏Փ˔.
 	*/
@@ -204,19 +456,101 @@ namespace Entity {
 		return true;
 	}
 
+	/**
+	* vJňoߎԂ擾.
+	*
+	* @param start vJn.
+	*
+	* @return oߎ(b).
+	*/
+	double ElapsedTime(const std::chrono::steady_clock::time_point& start){
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/**
+	* r[EvWFNVs񂩂王쐬.
+	*
+	* @param matVP r[EvWFNVs.
+	*
+	* @return [hWn̎.
+	*/
+	Frustum MakeFrustum(const glm::mat4& matVP){
+		// NbvW -w <= x, y, z <= w As̍s̘aƍŕ\镽ʂɕϊ.
+		const glm::mat4 m = glm::transpose(matVP);
+		Frustum f;
+		f.plane[0] = m[3] + m[0]; // .
+		f.plane[1] = m[3] - m[0]; // E.
+		f.plane[2] = m[3] + m[1]; // .
+		f.plane[3] = m[3] - m[1]; // .
+		f.plane[4] = m[3] + m[2]; // O.
+		f.plane[5] = m[3] - m[2]; // .
+		for (glm::vec4& p : f.plane) {
+			p /= glm::length(glm::vec3(p));
+		}
+		return f;
+	}
+
+	/**
+	* 4̋EƎ̌s.
+	*
+	* @param f .
+	* @param s E̔z.
+	*
+	* @return ƌ鋫EɑΉrbg1ɂl.
+	*/
+	int TestFrustumSphere4(const Frustum& f, const SphereBlock& s){
+#ifdef ENTITY_CULLING_USE_SSE
+		const __m128 x = _mm_loadu_ps(s.x);
+		const __m128 y = _mm_loadu_ps(s.y);
+		const __m128 z = _mm_loadu_ps(s.z);
+		const __m128 r = _mm_loadu_ps(s.r);
+		const __m128 zero = _mm_setzero_ps();
+		__m128 outside = zero;
+		for (const glm::vec4& p : f.plane) {
+			__m128 d = _mm_mul_ps(x, _mm_set1_ps(p.x));
+			d = _mm_add_ps(d, _mm_mul_ps(y, _mm_set1_ps(p.y)));
+			d = _mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(p.z)));
+			d = _mm_add_ps(d, _mm_add_ps(r, _mm_set1_ps(p.w)));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(d, zero));
+		}
+		return ~_mm_movemask_ps(outside) & 0xf;
+#else
+		int mask = 0;
+		for (int i = 0; i < 4; ++i) {
+			bool isInside = true;
+			for (const glm::vec4& p : f.plane) {
+				if (p.x * s.x[i] + p.y * s.y[i] + p.z * s.z[i] + p.w + s.r[i] < 0) {
+					isInside = false;
+					break;
+				}
+			}
+			mask |= isInside << i;
+		}
+		return mask;
+#endif
+	}
+
 	/**
 	* ANeBuȃGeBeB̏ԂXV.
 	*
 	* @param delta   O̍XV̌oߎ.
-	* @param matView Views.
-	* @param matProj Projections.
+	* @param matView Views(`揇̌Ɏg).
+	* @param matProj Projections(bV̏ڍדx̑IɎg).
+	* @param frustum . ESɊOɂGeBeB͕`悵Ȃ.
+	*
+	* `L[ɒǉGeBeB́AẺʏ̑傫ɍڍדx̃bVŕ`悷.
+	* e̎Ԃƌ Profile() Ŏ擾ł.
 	*/
-	void Buffer::Update(double delta, const glm::mat4& matView, const glm::mat4& matProj){
+	void Buffer::Update(double delta, const glm::mat4& matView, const glm::mat4& matProj, const Frustum& frustum){
+		profile = UpdateProfile();
+
 		// eGeBeB̍WƏԂXVA[hWn̏Փˌ`vZ.
+		auto start = std::chrono::steady_clock::now();
 		for (int groupId = 0; groupId <= maxGroupId; ++groupId) {
 			for (itrUpdate = activeList[groupId].next; itrUpdate != &activeList[groupId];
 				itrUpdate = itrUpdate->next) {
 				LinkEntity& e = *static_cast<LinkEntity*>(itrUpdate);
+				++profile.entityCount;
 				e.position += e.velocity * static_cast<float>(delta);
 				if (e.updateFunc) {
 					e.updateFunc(e, delta);
@@ -225,8 +559,10 @@ namespace Entity {
 				e.colWorld.max = e.colLocal.max + e.position;
 			}
 		}
+		profile.integrationTime = ElapsedTime(start);
 
 		// Փ˔s.
+		start = std::chrono::steady_clock::now();
 		for (const auto& e : collisionHandlerList) {
 			if (!e.handler) {
 				continue;
@@ -238,9 +574,11 @@ namespace Entity {
 				for (itrUpdateRhs = listR->next; itrUpdateRhs != listR;
 					itrUpdateRhs = itrUpdateRhs->next) {
 					LinkEntity* entityR = static_cast<LinkEntity*>(itrUpdateRhs);
+					++profile.collisionTestCount;
 					if (!HasCollision(entityL->colWorld, entityR->colWorld)) {
 						continue;
 					}
+					++profile.handlerCallCount;
 					e.handler(*entityL, *entityR);
 					if (entityL != itrUpdate) {
 						break; // ӂ폜ꂽꍇ͉Eӂ̃[vI.
@@ -250,42 +588,302 @@ namespace Entity {
 		}
 		itrUpdate = nullptr;
 		itrUpdateRhs = nullptr;
+		profile.collisionTime = ElapsedTime(start);
 
-		// UBOXV
-		uint8_t* p = static_cast<uint8_t*>(ubo->MapBuffer());
-		const glm::mat4 matVP = matProj * matView;
+		// `łGeBeB̋E[hWnɕϊA4܂Ƃ߂Ďƌ肷.
+		// ̊OɂGeBeB͕`L[ɒǉȂ̂ŁAUBO̍XVƕ`̗ȗ.
+		start = std::chrono::steady_clock::now();
+		cullingList.clear();
+		sphereList.clear();
 		for (int groupId = 0; groupId <= maxGroupId; ++groupId) {
-			for (itrUpdate = activeList[groupId].next; itrUpdate != &activeList[groupId];
-				itrUpdate = itrUpdate->next) {
-				LinkEntity& e = *static_cast<LinkEntity*>(itrUpdate);
-				UpdateUniformVertexData(e, p + e.uboOffset, matVP);
+			for (const Link* itr = activeList[groupId].next; itr != &activeList[groupId]; itr = itr->next) {
+				const LinkEntity& e = *static_cast<const LinkEntity*>(itr);
+				if (!e.mesh || !e.texture[0] || !e.texture[1] || !e.program) {
+					continue;
+				}
+				const size_t lane = cullingList.size() % 4;
+				if (lane == 0) {
+					sphereList.push_back(SphereBlock());
+				}
+				const Mesh::Bounds& bounds = e.mesh->GetBounds();
+				const glm::vec3 center = e.position + e.rotation * (bounds.center * e.scale);
+				const glm::vec3 absScale = glm::abs(e.scale);
+				SphereBlock& block = sphereList.back();
+				block.x[lane] = center.x;
+				block.y[lane] = center.y;
+				block.z[lane] = center.z;
+				block.r[lane] = bounds.radius * std::max(absScale.x, std::max(absScale.y, absScale.z));
+				cullingList.push_back(&e);
 			}
 		}
+		drawQueue.clear();
+		for (size_t i = 0; i < sphereList.size(); ++i) {
+			const int mask = TestFrustumSphere4(frustum, sphereList[i]);
+			const size_t count = std::min<size_t>(4, cullingList.size() - i * 4);
+			for (size_t lane = 0; lane < count; ++lane) {
+				if (!(mask & (1 << lane))) {
+					continue;
+				}
+				// E̔aAʂ̍̔1Ƃ傫ɓeďڍדxI.
+				const LinkEntity* e = cullingList[i * 4 + lane];
+				const SphereBlock& block = sphereList[i];
+				const float radius = block.r[lane];
+				const float depth = -(matView * glm::vec4(block.x[lane], block.y[lane], block.z[lane], 1)).z;
+				const Mesh::Mesh* mesh = depth > radius ? e->mesh->SelectLod(radius * matProj[1][1] / depth) : e->mesh.get();
+				if (mesh != e->mesh.get()) {
+					++profile.lodReducedCount;
+				}
+				drawQueue.push_back({ 0, e, mesh });
+			}
+		}
+		profile.visibleCount = drawQueue.size();
+		profile.culledCount = cullingList.size() - drawQueue.size();
+		profile.cullingTime = ElapsedTime(start);
+
+		// `L[̃GeBeBAsAwiȀɕĕבւ.
+		start = std::chrono::steady_clock::now();
+		for (DrawItem& item : drawQueue) {
+			const LinkEntity& e = *item.entity;
+			const float depth = -(matView * glm::vec4(e.position, 1)).z;
+			const RenderQueue queue = (e.queue == RenderQueue::Opaque && e.color.w < 1.0f) ? RenderQueue::Transparent : e.queue;
+			item.key = MakeSortKey(queue, e.program->Id(), e.texture[0]->Id(),
+				e.texture[1]->Id(), item.mesh->BeginMaterial(), depth);
+		}
+		if (!drawQueue.empty()) {
+			RadixSort(drawQueue, drawQueueTmp);
+		}
+		profile.sortTime = ElapsedTime(start);
+
+		// בւɁAvOƂ̃yC[h`UBOXV.
+		// CX^X`p̃VF[_AVF[_AeNX`AbVGeBeB
+		// UBOŘAāA1̕`施߂ŕ`ł悤ɂ܂Ƃ߂.
+		// eNX`z̑w̓eNX`z񂪓Ȃ瓯eNX`ƂĈAw̔ԍ̓yC[hœn.
+		// Ԑڕ`p̃VF[_vÕyC[hSSBOɏ݁AvOƂ1̔zɂ.
+		// z̗vfɏ͂Ȃ߁ACX^X̐Ȃɂ܂Ƃ߂.
+		start = std::chrono::steady_clock::now();
+		batchList.clear();
+		uint8_t* p = static_cast<uint8_t*>(ubo->MapBuffer());
+		uint8_t* pStorage = isIndirect ?
+			static_cast<uint8_t*>(payloadStorage.MapBuffer(GL_SHADER_STORAGE_BUFFER, payloadStorage.Size())) : nullptr;
+		GLintptr offset = 0;
+		GLintptr storageOffset = 0;
+		for (const DrawItem& item : drawQueue) {
+			const LinkEntity& e = *item.entity;
+			const RenderQueue queue = static_cast<RenderQueue>(item.key >> sortQueueShift);
+			const bool indirect = pStorage && e.program->Indirect();
+			DrawBatch* batch = batchList.empty() ? nullptr : &batchList.back();
+			if (batch && batch->queue == queue && batch->program == e.program.get() &&
+				batch->mesh == item.mesh && batch->texture[0] == BindingTexture(e.texture[0]) &&
+				batch->texture[1] == BindingTexture(e.texture[1]) &&
+				(indirect || (batch->program->Instanced() && batch->instanceCount < Uniform::maxInstanceCount))) {
+				++batch->instanceCount;
+			} else {
+				const auto itrPayload = payloadMap.find(e.program.get());
+				const PayloadInfo* payload = itrPayload != payloadMap.end() ? &itrPayload->second : &defaultPayload;
+				if (indirect) {
+					GLintptr arrayOffset;
+					GLuint firstInstance = 0;
+					if (batch && batch->isIndirect && batch->program == e.program.get()) {
+						arrayOffset = batch->uboOffset;
+						firstInstance = batch->firstInstance + batch->instanceCount;
+					} else {
+						storageOffset = (storageOffset + storageAlignment - 1) / storageAlignment * storageAlignment;
+						arrayOffset = storageOffset;
+					}
+					batchList.push_back({ arrayOffset, 1, payload, item.mesh, e.program.get(),
+						{ BindingTexture(e.texture[0]), BindingTexture(e.texture[1]) }, true, firstInstance, 0, 0, queue });
+				} else {
+					offset = (offset + ubAlignment - 1) / ubAlignment * ubAlignment;
+					batchList.push_back({ offset, 1, payload, item.mesh, e.program.get(),
+						{ BindingTexture(e.texture[0]), BindingTexture(e.texture[1]) }, false, 0, 0, 0, queue });
+				}
+				batch = &batchList.back();
+			}
+			if (batch->isIndirect) {
+				batch->payload->pack(e, pStorage + storageOffset);
+				storageOffset += batch->payload->size;
+			} else {
+				batch->payload->pack(e, p + offset);
+				offset += batch->payload->size;
+			}
+			profile.uploadBytes += batch->payload->size;
+		}
 		ubo->UnmapBuffer();
+		profile.uboWaitTime = ubo->FenceWaitTime();
+		if (pStorage) {
+			payloadStorage.UnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+		}
+		payloadStorageSize = storageOffset;
+		profile.uploadTime = ElapsedTime(start);
 	}
 
 	/**
 	* ANeBuȃGeBeB`悷.
 	*
 	* @param meshBuffer `Ɏgp郁bVobt@ւ̃|C^.
+	*
+	* Update ō쐬`Pʂ̏ɕ`悷.
+	* sAwiA̕`L[؂ւƂŁAuhƐ[xeXg̏Ԃ؂ւ.
+	* wi̕`֐ݒ肳Ă΁AšɔwiL[̏ԂňxĂяo.
+	* CX^X`p̃VF[_`Pʂ́A܂Ƃ߂GeBeB1̕`施߂ŕ`悷.
+	* Ԑڕ`悪LȏꍇAԐڕ`p̃VF[_`Pʂ̓}eAƂ̃R}h쐬A
+	* VF[_ƃeNX`Ԃ1 glMultiDrawElementsIndirect ŕ`悷.
+	* OƓVF[_eNX`̊蓖Ă͏ȗ.
+	* `施߂Əȗ蓖Ă̐ GetDrawStats() Ŏ擾ł.
 	*/
-	void Buffer::Draw(const Mesh::BufferPtr& meshBuffer) const{
+	void Buffer::Draw(const Mesh::BufferPtr& meshBuffer){
+		drawStats = DrawStats();
 		meshBuffer->BindVAO();
-		for (int groupId = 0; groupId <= maxGroupId; ++groupId) {
-			for (const Link* itr = activeList[groupId].next; itr != &activeList[groupId];
-				itr = itr->next) {
-				const LinkEntity& e = *static_cast<const LinkEntity*>(itr);
-				if (e.mesh && e.texture && e.program) {
-					e.program->UseProgram();
-					// eNX`Tv[Ɋ蓖Ă.
-					for (size_t i = 0; i < sizeof(e.texture) / sizeof(e.texture[0]); ++i) {
-						e.program->BindTexture(
-							GL_TEXTURE0 + i, GL_TEXTURE_2D, e.texture[i]->Id());
+
+		// Ԑڕ`Pʂ̃bṼ}eAƂɁA`R}hƕ`CfbNXƂ̃f[^쐬.
+		// `CfbNX baseInstance + CX^XԍɂȂ̂ŁAR}hƂɘA͈͂蓖Ă.
+		commandList.clear();
+		if (isIndirect && meshBuffer->GetIndirectMode() != Mesh::IndirectMode::None) {
+			Uniform::DrawData* pDrawData = static_cast<Uniform::DrawData*>(
+				drawDataStorage.MapBuffer(GL_SHADER_STORAGE_BUFFER, drawDataStorage.Size()));
+			const GLuint maxDrawDataCount = static_cast<GLuint>(drawDataStorage.Size() / sizeof(Uniform::DrawData));
+			GLuint drawDataCount = 0;
+			for (DrawBatch& batch : batchList) {
+				if (!batch.isIndirect) {
+					continue;
+				}
+				batch.firstCommand = static_cast<GLsizei>(commandList.size());
+				for (size_t i = batch.mesh->BeginMaterial(); i < batch.mesh->EndMaterial(); ++i) {
+					if (drawDataCount + batch.instanceCount > maxDrawDataCount) {
+						std::cerr << "WARNING in Entity::Buffer::Draw: `CfbNXsĂ܂(" <<
+							maxDrawDataCount << ")." << std::endl;
+						break;
+					}
+					const Mesh::Material& m = meshBuffer->GetMaterial(i);
+					commandList.push_back({ static_cast<GLuint>(m.size), static_cast<GLuint>(batch.instanceCount),
+						static_cast<GLuint>(reinterpret_cast<uintptr_t>(m.offset) / sizeof(GLuint)), m.baseVertex, drawDataCount });
+					for (GLsizei n = 0; n < batch.instanceCount; ++n) {
+						pDrawData[drawDataCount++] = { batch.firstInstance + n };
 					}
-					ubo->BindBufferRange(e.uboOffset, ubSizePerEntity);
-					e.mesh->Draw(meshBuffer);
+				}
+				batch.commandCount = static_cast<GLsizei>(commandList.size()) - batch.firstCommand;
+			}
+			drawDataStorage.UnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+			if (!commandList.empty()) {
+				const GLsizeiptr commandBytes = commandList.size() * sizeof(Mesh::DrawElementsIndirectCommand);
+				memcpy(commandBuffer.MapBuffer(GL_DRAW_INDIRECT_BUFFER, commandBytes), commandList.data(), commandBytes);
+				commandBuffer.UnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
+				drawDataStorage.BindBufferRange(GL_SHADER_STORAGE_BUFFER, drawDataStorageBindingPoint,
+					0, drawDataCount * sizeof(Uniform::DrawData));
+			}
+		}
+
+		Shader::Program* currentProgram = nullptr;
+		const Texture* currentTexture[2] = {};
+		GLintptr currentStorageOffset = -1;
+		BindQueueState(RenderQueue::Opaque);
+		RenderQueue currentQueue = RenderQueue::Opaque;
+		bool isBackgroundDrawn = !backgroundFunc;
+		const auto drawBackground = [&]() {
+			BindQueueState(RenderQueue::Background);
+			currentQueue = RenderQueue::Background;
+			backgroundFunc();
+			// wi̕`֐VAOAVF[_AeNX`ύX̂ŁA̕`PʂŊ蓖Ē.
+			meshBuffer->BindVAO();
+			currentProgram = nullptr;
+			currentTexture[0] = currentTexture[1] = nullptr;
+			isBackgroundDrawn = true;
+		};
+		for (auto itr = batchList.begin(); itr != batchList.end(); ++itr) {
+			const DrawBatch& batch = *itr;
+			if (batch.isIndirect && commandList.empty()) {
+				continue;
+			}
+			if (!isBackgroundDrawn && batch.queue != RenderQueue::Opaque) {
+				drawBackground();
+			}
+			if (batch.queue != currentQueue) {
+				BindQueueState(batch.queue);
+				currentQueue = batch.queue;
+			}
+			Shader::Program* program = batch.program;
+			if (batch.isIndirect) {
+				program = batch.program->Indirect().get();
+			} else if (batch.program->Instanced()) {
+				program = batch.program->Instanced().get();
+			}
+			if (program != currentProgram) {
+				program->UseProgram();
+				currentProgram = program;
+				++drawStats.programBindCount;
+			} else {
+				++drawStats.programSkipCount;
+			}
+			// eNX`Tv[Ɋ蓖Ă.
+			for (size_t i = 0; i < sizeof(batch.texture) / sizeof(batch.texture[0]); ++i) {
+				if (batch.texture[i] == currentTexture[i]) {
+					++drawStats.textureSkipCount;
+				} else if (program->BindTexture(GL_TEXTURE0 + i, batch.texture[i]->Target(), batch.texture[i]->Id())) {
+					currentTexture[i] = batch.texture[i];
+					++drawStats.textureBindCount;
 				}
 			}
+			if (batch.isIndirect) {
+				// VF[_ƃeNX`Ԑڕ`Pʂ́AR}hAĂ̂ł܂Ƃ߂Ĕs.
+				if (batch.uboOffset != currentStorageOffset) {
+					payloadStorage.BindBufferRange(GL_SHADER_STORAGE_BUFFER, payloadStorageBindingPoint,
+						batch.uboOffset, payloadStorageSize - batch.uboOffset);
+					currentStorageOffset = batch.uboOffset;
+				}
+				auto itrEnd = itr;
+				size_t commandCount = 0;
+				for (; itrEnd != batchList.end() && itrEnd->isIndirect && itrEnd->queue == batch.queue && itrEnd->program == batch.program &&
+					itrEnd->texture[0] == batch.texture[0] && itrEnd->texture[1] == batch.texture[1]; ++itrEnd) {
+					const size_t materialCount = itrEnd->mesh->EndMaterial() - itrEnd->mesh->BeginMaterial();
+					commandCount += itrEnd->commandCount;
+					drawStats.drawCount += itrEnd->instanceCount;
+					drawStats.triangleCount += itrEnd->mesh->TriangleCount() * itrEnd->instanceCount;
+					CountQueue(itrEnd->queue, itrEnd->instanceCount);
+					++drawStats.batchCount;
+					drawStats.drawCallCountWithoutInstancing += materialCount * itrEnd->instanceCount;
+				}
+				meshBuffer->DrawIndirect(commandBuffer.Id(), commandList.data(),
+					batch.firstCommand, static_cast<GLsizei>(commandCount));
+				drawStats.indirectCommandCount += commandCount;
+				drawStats.drawCallCount +=
+					meshBuffer->GetIndirectMode() == Mesh::IndirectMode::MultiDraw ? 1 : commandCount;
+				itr = itrEnd - 1;
+				continue;
+			}
+			const size_t materialCount = batch.mesh->EndMaterial() - batch.mesh->BeginMaterial();
+			if (batch.program->Instanced()) {
+				// VF[_͍őCX^X̔z錾Ă̂ŁA͈̔͂蓖Ă.
+				ubo->BindBufferRange(batch.uboOffset, batch.payload->size * Uniform::maxInstanceCount);
+				batch.mesh->Draw(meshBuffer, batch.instanceCount);
+			} else {
+				ubo->BindBufferRange(batch.uboOffset, batch.payload->size);
+				batch.mesh->Draw(meshBuffer);
+			}
+			drawStats.drawCount += batch.instanceCount;
+			drawStats.triangleCount += batch.mesh->TriangleCount() * batch.instanceCount;
+			CountQueue(batch.queue, batch.instanceCount);
+			++drawStats.batchCount;
+			drawStats.drawCallCount += materialCount;
+			drawStats.drawCallCountWithoutInstancing += materialCount * batch.instanceCount;
+		}
+		if (!isBackgroundDrawn) {
+			drawBackground();
+		}
+		// [xobt@̃NAȂǁȀ݂KvƂ̂ŕs̏Ԃɖ߂Ă.
+		BindQueueState(RenderQueue::Opaque);
+	}
+
+	/**
+	* `L[Ƃ̃GeBeB̐L^.
+	*
+	* @param queue `L[.
+	* @param count `悵GeBeB̐.
+	*/
+	void Buffer::CountQueue(RenderQueue queue, GLsizei count){
+		if (queue == RenderQueue::Background) {
+			drawStats.backgroundCount += count;
+		} else if (queue == RenderQueue::Transparent) {
+			drawStats.transparentCount += count;
 		}
 	}
 
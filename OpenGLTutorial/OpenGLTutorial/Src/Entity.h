@@ -9,11 +9,15 @@
 #include "Texture.h"
 #include "Shader.h"
 #include "UniformBuffer.h"
+#include "BufferObject.h"
+#include "Uniform.h"
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <memory>
 #include <functional>
 #include <vector>
+#include <unordered_map>
+#include <string.h>
 
 namespace Entity {
 
@@ -25,6 +29,8 @@ namespace Entity {
 	typedef std::function<void(Entity&, Entity&)> CollisionHandlerType; 
 
 	static const int maxGroupId = 31; ///< O[v ID ̍ől.
+	static const GLuint payloadStorageBindingPoint = 0; ///< Ԑڕ`ŃyC[h蓖ĂSSBÕoCfBOE|Cg.
+	static const GLuint drawDataStorageBindingPoint = 1; ///< Ԑڕ` Uniform::DrawData 蓖ĂSSBÕoCfBOE|Cg.
 
 	/**
 	* Փ˔`.
@@ -34,6 +40,110 @@ namespace Entity {
 		glm::vec3 max;
 	};
 
+	/**
+	* .
+	*/
+	struct Frustum {
+		glm::vec4 plane[6]; ///< [hWn̕(xyz͓̒Pʖ@Aw͌_̋).
+	};
+	Frustum MakeFrustum(const glm::mat4& matVP);
+
+	/**
+	* JO4܂Ƃ߂čs߂̋E̔z.
+	*/
+	struct SphereBlock {
+		float x[4]; ///< SXW.
+		float y[4]; ///< SYW.
+		float z[4]; ///< SZW.
+		float r[4]; ///< a.
+	};
+
+	/**
+	* Buffer::Update ̌v.
+	*/
+	struct UpdateProfile {
+		size_t entityCount = 0; ///< XVGeBeB̐.
+		double integrationTime = 0; ///< WƏԂ̍XVɂ(b).
+		double collisionTime = 0; ///< Փ˔ɂ(b).
+		double cullingTime = 0; ///< JOɂ(b).
+		double sortTime = 0; ///< `L[̍쐬ƕבւɂ(b).
+		double uploadTime = 0; ///< UBO̍XVɂ(b).
+		double uboWaitTime = 0; ///< uploadTime ̂AUBÖ̗g`̊҂(b).
+		size_t collisionTestCount = 0; ///< Փ˔sGeBeB̑g̐.
+		size_t handlerCallCount = 0; ///< ՓˉnhĂяo.
+		size_t visibleCount = 0; ///< ̓ɂ`L[ɒǉGeBeB̐.
+		size_t culledCount = 0; ///< ̊Oɂ`悵ȂGeBeB̐.
+		size_t lodReducedCount = 0; ///< ڍדxbVI񂾃GeBeB̐.
+		size_t uploadBytes = 0; ///< UBOɏ񂾃oCg.
+	};
+
+	/**
+	* Buffer::Draw Ŕs`Ԃ̕ύX̐.
+	*/
+	struct DrawStats {
+		size_t drawCount = 0; ///< `悵GeBeB̐.
+		size_t batchCount = 0; ///< VF[_AeNX`AbVGeBeB܂Ƃ߂`Pʂ̐.
+		size_t drawCallCount = 0; ///< s`施߂̐.
+		size_t drawCallCountWithoutInstancing = 0; ///< CX^X`gȂꍇ̕`施߂̐.
+		size_t indirectCommandCount = 0; ///< Ԑڕ`ŔsR}h̐.
+		size_t programBindCount = 0; ///< VF[_؂ւ.
+		size_t programSkipCount = 0; ///< OƓVF[_̂Ő؂ւȗ.
+		size_t textureBindCount = 0; ///< eNX`蓖Ă.
+		size_t textureSkipCount = 0; ///< OƓeNX`̂Ŋ蓖Ăȗ.
+		size_t backgroundCount = 0; ///< wiƂĕ`悵GeBeB̐.
+		size_t transparentCount = 0; ///< Ƃĕ`悵GeBeB̐.
+		size_t triangleCount = 0; ///< `悵Op`̐.
+	};
+
+	/**
+	* `L[̎.
+	*
+	* Opaque, Background, Transparent ̏ɕ`悳.
+	*/
+	enum class RenderQueue {
+		Opaque, ///< s. uhɎO牜֕`悷. F̃At@1ȂTransparentƂĈ.
+		Background, ///< wi. šɍő[xŕ`悷̂ŁAsɉB镔͑[xeXgŏO.
+		Transparent, ///< . [x܂ɉOփuh.
+	};
+
+	/**
+	* GeBeBƂUBO֏ރf[^(yC[h)̌`.
+	*/
+	struct PayloadInfo {
+		GLsizeiptr size; ///< 1GeBeB̃oCg.
+		void(*pack)(const Entity&, void*); ///< GeBeB̏ԂyC[hɕϊďފ֐.
+	};
+
+	/**
+	* yC[h^Ƃ̕ϊ@.
+	*
+	* yC[h^ƂɓꉻAstatic void Pack(const Entity&, T&) `.
+	*/
+	template<typename T> struct PayloadTraits;
+
+	/// Tutorial VF[_p̃yC[h.
+	template<> struct PayloadTraits<Uniform::VertexData> {
+		static void Pack(const Entity& entity, Uniform::VertexData& data);
+	};
+
+	/// NonLighting VF[_p̃yC[h.
+	template<> struct PayloadTraits<Uniform::CompactVertexData> {
+		static void Pack(const Entity& entity, Uniform::CompactVertexData& data);
+	};
+
+	/**
+	* yC[h^TŃGeBeB̏Ԃ.
+	*
+	* @param entity ރGeBeB.
+	* @param p      ݐ̃AhX.
+	*/
+	template<typename T>
+	void PackPayload(const Entity& entity, void* p){
+		T data;
+		PayloadTraits<T>::Pack(entity, data);
+		memcpy(p, &data, sizeof(T));
+	}
+
 	/**
 	* GeBeB.
 	*/
@@ -58,6 +168,10 @@ namespace Entity {
 		const UpdateFuncType& UpdateFunc() const { return updateFunc; }
 		void Collision(const CollisionData& c) { colLocal = c; }
 		const CollisionData& Collision() const { return colLocal; }
+		void Queue(RenderQueue q) { queue = q; }
+		RenderQueue Queue() const { return queue; }
+		/// eNX`擾(0: J[, 1: m[}}bv).
+		const TexturePtr& GetTexture(int n) const { return texture[n]; }
 
 		glm::mat4 TRSMatrix() const;
 		int GroupId() const { return groupId; }
@@ -81,10 +195,10 @@ namespace Entity {
 		Mesh::MeshPtr mesh; ///< GeBeB`悷ƂɎg郁bVf[^.
 		TexturePtr texture[2]; ///< GeBeB`悷ƂɎgeNX`.
 		Shader::ProgramPtr program; ///< GeBeB`悷ƂɎgVF[_.
-		GLintptr uboOffset; ///< UBÕGeBeBp̈ւ̃oCgItZbg.
 		UpdateFuncType updateFunc; ///< ԍXV֐.
 		CollisionData colLocal; ///< [JWn̏Փˌ`.
 		CollisionData colWorld; ///< [hWn̏Փˌ`.
+		RenderQueue queue = RenderQueue::Opaque; ///< `L[.
 		bool isActive = false; ///< ANeBuȃGeBeBȂtrueAANeBuȂfalse.
 	};
 
@@ -93,20 +207,46 @@ namespace Entity {
 	*/
 	class Buffer{
 	public:
-		static BufferPtr Create(size_t maxEntityCount, GLsizeiptr ubSizePerEntity, int bindingPoint, const char* name);
+		static BufferPtr Create(size_t maxEntityCount, GLsizeiptr ubSizePerEntity, int bindingPoint, const char* name,
+			int uboFrameCount = 1);
 
 		Entity* AddEntity(int groupId, const glm::vec3& pos, 
 			const Mesh::MeshPtr& m, const TexturePtr t[2],
 			const Shader::ProgramPtr& p, Entity::UpdateFuncType func
 		);
 		void RemoveEntity(Entity* entity);
-		void Update(double delta, const glm::mat4& matView, const glm::mat4& matProj);
-		void Draw(const Mesh::BufferPtr& meshBuffer) const;
+		void Update(double delta, const glm::mat4& matView, const glm::mat4& matProj, const Frustum& frustum);
+		void Draw(const Mesh::BufferPtr& meshBuffer);
+		void NextFrame() { ubo->NextFrame(); }
+		/// wiL[̏ԂŁAwiL[̃GeBeBɌĂяo`֐̌^.
+		typedef std::function<void()> BackgroundFuncType;
+		/// wiL[̏ԂŌĂяo`֐ݒ肷. nullptrȂĂяoȂ.
+		void BackgroundFunc(const BackgroundFuncType& func) { backgroundFunc = func; }
 
 		void CollisionHandler(int gid0, int gid1, CollisionHandlerType handler);
 		const CollisionHandlerType& CollisionHandler(int gid0, int gid1) const;
 		void ClearCollisionHandlerList();
 
+		const UpdateProfile& Profile() const { return profile; }
+		const DrawStats& GetDrawStats() const { return drawStats; }
+		bool Indirect(bool enable);
+		bool Indirect() const { return isIndirect; }
+
+		/**
+		* vOŕ`悷GeBeB̃yC[h^ݒ肷.
+		*
+		* @tparam T      yC[h^. std140̔zƂēǂ߂悤16oCg̔{łȂ΂ȂȂ.
+		* @param program yC[h^ݒ肷vO.
+		*
+		* ݒ肵ĂȂvOɂ Uniform::VertexData g.
+		*/
+		template<typename T>
+		bool Payload(const Shader::ProgramPtr& program) {
+			static_assert(sizeof(T) % 16 == 0, "yC[h^̃TCY16oCg̔{łȂ΂ȂȂ");
+			return Payload(program, { sizeof(T), &PackPayload<T> });
+		}
+		bool Payload(const Shader::ProgramPtr& program, const PayloadInfo& payload);
+
 	private:
 		Buffer() = default;
 		~Buffer() = default;
@@ -125,13 +265,47 @@ namespace Entity {
 		struct LinkEntity : public Link, public Entity {};
 		/// NtGeBeBz̍폜֐.
 		struct EntityArrayDeleter { void operator()(LinkEntity* p) { delete[] p; } };
+		/// `L[̗vf.
+		struct DrawItem {
+			uint64_t key; ///< בւL[(`L[AVF[_AeNX`AbVA[x).
+			const LinkEntity* entity; ///< `悷GeBeB.
+			const Mesh::Mesh* mesh; ///< ʏ̑傫I񂾏ڍדx̃bV.
+		};
+		/**
+		* 1̕`施߂ŕ`悷GeBeB̂܂Ƃ܂.
+		*
+		* Draw ̑OɃGeBeB폜Ă`ł悤ɁA`ɕKvȏێ.
+		*/
+		struct DrawBatch {
+			GLintptr uboOffset; ///< 擪̃GeBeBUBOf[^ւ̃oCgItZbg.
+			GLsizei instanceCount; ///< GeBeB̐.
+			const PayloadInfo* payload; ///< UBOf[^̌`.
+			const Mesh::Mesh* mesh; ///< `悷郁bV.
+			Shader::Program* program; ///< `ɎgVF[_.
+			const Texture* texture[2]; ///< `ɎgeNX`(eNX`z̑w̏ꍇ̓eNX`z).
+			bool isIndirect; ///< Ԑڕ`ŕ`悷Ȃtrue. uboOffsetSSBÕyC[hz̐擪w.
+			GLuint firstInstance; ///< 擪̃GeBeB̃yC[hz̔ԍ(Ԑڕ`̂).
+			GLsizei firstCommand; ///< 擪̊Ԑڕ`R}h̔ԍ(Ԑڕ`̂).
+			GLsizei commandCount; ///< Ԑڕ`R}h̐(Ԑڕ`̂).
+			RenderQueue queue; ///< `L[.
+		};
 
 		std::unique_ptr<LinkEntity[], EntityArrayDeleter> buffer; ///< GeBeB̔z. 
 		size_t bufferSize; ///< GeBeB̑.
 		Link freeList; ///< gp̃GeBeB̃NXg.
 		Link activeList[maxGroupId + 1]; ///< gp̃GeBeB̃NXg.
-		GLsizeiptr ubSizePerEntity; ///< eGeBeBg Uniform Buffer ̃oCg.
+		GLsizeiptr ubSizePerEntity; ///< eGeBeBg Uniform Buffer ̍őoCg.
+		PayloadInfo defaultPayload; ///< yC[h^ݒ肵ĂȂvOɎgyC[h.
+		std::unordered_map<const Shader::Program*, PayloadInfo> payloadMap; ///< vOƂ̃yC[h.
+		GLintptr ubAlignment; ///< `PʂƂUBOf[^̊JnʒűE.
+		GLintptr storageAlignment; ///< `PʂƂSSBOf[^̊JnʒűE.
 		UniformBufferPtr ubo; ///< GeBeBp UBO.
+		bool isIndirect = false; ///< Ԑڕ`p̃VF[_vOԐڕ`ŕ`悷Ȃtrue.
+		BufferObject payloadStorage; ///< Ԑڕ`p̃yC[hi[SSBO.
+		BufferObject drawDataStorage; ///< Ԑڕ`p Uniform::DrawData i[SSBO.
+		BufferObject commandBuffer; ///< Ԑڕ`R}hi[obt@.
+		GLsizeiptr payloadStorageSize = 0; ///< O Update SSBOɏ񂾃yC[h̏I[.
+		std::vector<Mesh::DrawElementsIndirectCommand> commandList; ///< Ԑڕ`R}h̃Xg.
 		Link* itrUpdate = nullptr; ///< Update  RemoveEntity ̑ݍpɑΉ邽߂̃Ce[^.
 		Link* itrUpdateRhs = nullptr;
 
@@ -140,6 +314,16 @@ namespace Entity {
 			CollisionHandlerType handler;
 		};
 		std::vector<CollisionHandlerInfo> collisionHandlerList;
+		UpdateProfile profile; ///< O Update ̌v.
+
+		std::vector<const LinkEntity*> cullingList; ///< JȎΏۂɂȂGeBeB̃Xg.
+		std::vector<SphereBlock> sphereList; ///< cullingList ̊eGeBeB̃[hWn̋E.
+		std::vector<DrawItem> drawQueue; ///< `揇ɕׂGeBeB̃Xg.
+		std::vector<DrawItem> drawQueueTmp; ///< בւ̍Ɨ̈.
+		std::vector<DrawBatch> batchList; ///< `施߂̃Xg.
+		DrawStats drawStats; ///< O Draw ̕`Ԃ̕ύX̐.
+		void CountQueue(RenderQueue queue, GLsizei count);
+		BackgroundFuncType backgroundFunc; ///< wiL[̏ԂŌĂяo`֐.
 	};
 }
 
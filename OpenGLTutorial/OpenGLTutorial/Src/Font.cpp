@@ -4,6 +4,7 @@
 
 #include "Font.h"
 #include "GameEngine.h"//eNX`ǂݍނ
+#include "GLRecorder.h"
 #include <memory>//std::unique_ptrp
 #include <iostream>//fobOo͗p
 #include <stdio.h>//t@Cǂݍ
@@ -27,11 +28,13 @@ namespace Font {
 	*
 	* @param maxChar ő`敶.
 	* @param screen  `XN[̑傫.
+	* @param batch   VF[_܂Ƃ߂č쐬ꍇ͂̃ob`. nullptrȂ炱ō쐬.
+	*                ob`w肵ꍇA`悷OɃob`FinishĂяo.
 	*
 	* @retval true  .
 	* @retval false s.
 	*/
-	bool Renderer::Init(size_t maxChar, const glm::vec2& screen){
+	bool Renderer::Init(size_t maxChar, const glm::vec2& screen, Shader::ProgramBatch* batch){
 		// i[\ȍő啶RendererNXłőlɐ
 		if (maxChar > (USHRT_MAX + 1) / 4) {
 			std::cerr << "WARNING: " << maxChar << "͐ݒ\ȍő啶zĂ܂" << std::endl;
@@ -65,10 +68,17 @@ namespace Font {
 		vao.Unbind();
 
 		// tHg`p̃VF[_̓ǂݍ
-		progFont = Shader::Program::Create("Res/Font.vert", "Res/Font.frag");
+		if (batch) {
+			progFont = batch->Add("Res/Font.vert", "Res/Font.frag");
+		} else {
+			progFont = Shader::Program::Create("Res/Font.vert", "Res/Font.frag");
+		}
 		if (!progFont) {
 			return false;
 		}
+		// ׂĂ͓̕ZW߁A㏑ł悤ɐ[xeXg𖳌.
+		// ɂ͓ȕ̂ŁAAt@uhL.
+		pipeline = GLState::Pipeline::Create(progFont, { false, false, true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA });
 
 		// XN[̑傫̋treciprocalScreenSizeϐɕۑ
 		reciprocalScreenSize = 2.0f / screen;//XN[̍W-1`+1͈̔͂邽2.0fƂ.
@@ -270,13 +280,8 @@ namespace Font {
 		}
 		// OpenGLVXeɃtHgpVAO蓖.
 		vao.Bind();
-		// ׂĂ͓̕ZW߁A㏑ł悤ɐ[xeXg𖳌.
-		glDisable(GL_DEPTH_TEST);
-		// ɂ͓ȕ̂ŁAAt@uhL.
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		// tHgpVF[_[vO蓖.
-		progFont->UseProgram();
+		// tHgp̃VF[_ƕ`Ԃ蓖.
+		pipeline->Bind();
 		// eNX`oCh.
 		progFont->BindTexture(GL_TEXTURE0, GL_TEXTURE_2D,
 			GameEngine::Instance().GetTexture(texFilename.c_str())->Id());
@@ -8,6 +8,7 @@
 #include <GL/glew.h>
 #include "BufferObject.h"//tHg\邽߂̃obt@IuWFN쐬邽
 #include "Shader.h"//tHg\p̃VF[_Ǘ邽
+#include "GLState.h"//`Ԃ܂Ƃ߂Đݒ肷邽
 #include <glm/glm.hpp>//WxNg^ŕ\邽
 #include <vector>//ʒuێ邽
 #include <string>//eNX`ێ邽
@@ -35,7 +36,7 @@ namespace Font {
 		Renderer(const Renderer&) = delete;
 		Renderer& operator=(const Renderer&) = delete;
 
-		bool Init(size_t maxChar, const glm::vec2& ss);
+		bool Init(size_t maxChar, const glm::vec2& ss, Shader::ProgramBatch* batch = nullptr);
 		bool LoadFromFile(const char* filename);
 
 		void Scale(const glm::vec2& s) { scale = s; }
@@ -56,6 +57,7 @@ namespace Font {
 		std::vector<FontInfo> fontList; ///< tHgʒũXg.
 		std::string texFilename;        ///< tHgeNX`t@C.
 		Shader::ProgramPtr progFont;    ///< tHg`pVF[_vO.
+		GLState::PipelinePtr pipeline;  ///< tHg`ppCvC.
 		glm::vec2 reciprocalScreenSize; ///< ʃTCY̋t.
 
 		glm::vec2 scale = glm::vec2(1, 1); ///< tHg`悷Ƃ̊g嗦.
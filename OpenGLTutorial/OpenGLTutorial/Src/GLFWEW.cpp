@@ -53,16 +53,24 @@ namespace GLFWEW {
 	* @param w EBhE̕`͈͂̕(sNZ).
 	* @param h EBhE̕`͈͂̍(sNZ).
 	* @param title EBhE^Cg(UTF-8  0 I[).
+	* @param type  ReLXg̍쐬@.
+	*              ContextType::Headless ̏ꍇAw, h ̑傫̕\ȂEBhE쐬.
 	*
 	* @retval true .
 	* @retval false s.
 	*/
-	bool Window::Init(int w, int h, const char* title) {
+	bool Window::Init(int w, int h, const char* title, ContextType type) {
 		if (isInitialized) {
 			std::cerr << "ERROR: GLFWEW ͊ɏĂ܂." << std::endl;
 			return false;
 		}
-		if (!isGLFWInitialized) {
+		contextType = type;
+		startTime = std::chrono::steady_clock::now();
+		if (type == ContextType::Headless) {
+			if (!InitHeadless(w, h, title)) {
+				return false;
+			}
+		} else if (!isGLFWInitialized) {
 			//glfwSetErrorCallback(ErrorCallback);
 			if (glfwInit() != GL_TRUE) {
 				return false;
@@ -91,6 +99,37 @@ namespace GLFWEW {
 		return true;
 	}
 
+	/**
+	* \ȂEBhE쐬.
+	*
+	* @param w     `͈͂̕(sNZ).
+	* @param h     `͈͂̍(sNZ).
+	* @param title EBhE^Cg.
+	*
+	* @retval true 쐬.
+	* @retval false 쐬s.
+	*
+	* \Ȃ̒ʏGLFWEBhEȂ̂ŁAEBhEVXe(XWayland)̂Ȃł͍쐬Ɏs.
+	*/
+	bool Window::InitHeadless(int w, int h, const char* title) {
+		if (!isGLFWInitialized) {
+			if (glfwInit() != GL_TRUE) {
+				return false;
+			}
+			isGLFWInitialized = true;
+		}
+		glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+		window = glfwCreateWindow(w, h, title, nullptr, nullptr);
+		glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
+		if (!window) {
+			return false;
+		}
+		glfwMakeContextCurrent(window);
+		// \ȂEBhE͐҂KvȂ.
+		glfwSwapInterval(0);
+		return true;
+	}
+
 	/**
 	* EBhEׂׂ.
 	*
@@ -109,6 +148,16 @@ namespace GLFWEW {
 		glfwSwapBuffers(window);
 	}
 
+	/**
+	* oߎԂ擾.
+	*
+	* @return InitĂяoĂ̌oߎ(b).
+	*/
+	double Window::Time() const {
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+		return elapsed.count();
+	}
+
 	/**
 	* Q[pbh̏Ԃ擾.
 	*
@@ -157,6 +206,9 @@ namespace GLFWEW {
 	* Q[pbh̏ԂXV.
 	*/
 	void Window::UpdateGamePad(){
+		if (IsHeadless()) {
+			return; // ͑uȂ̂ŁAĂȂԂ̂܂܂ɂ.
+		}
 		const uint32_t prevButtons = gamepad.buttons;
 		int axesCount, buttonCount;
 		const float* axes = glfwGetJoystickAxes(GLFW_JOYSTICK_1, &axesCount);
@@ -7,17 +7,28 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include "GamePad.h"
+#include <chrono>
 
 namespace GLFWEW {
+	/**
+	* OpenGLReLXg̍쐬@.
+	*/
+	enum class ContextType {
+		Window, ///< GLFW̃EBhE쐬.
+		Headless, ///< GLFW̃EBhE\ɍ쐬(EBhEVXe͕Kv).
+	};
+
 	/**
 	* GLFW  GLEW ̃bp[NX
 	*/
 	class Window {
 	public:
 		static Window& Instance();
-		bool Init(int w, int h, const char* title);
+		bool Init(int w, int h, const char* title, ContextType type = ContextType::Window);
+		bool IsHeadless() const { return contextType == ContextType::Headless; }
 		bool ShouldClose() const;
 		void SwapBuffers() const;
+		double Time() const;
 		const GamePad& GetGamePad() const;
 		void UpdateGamePad();
 
@@ -27,10 +38,14 @@ namespace GLFWEW {
 		Window(const Window&) = delete;
 		Window& operator=(const Window&) = delete;
 
+		bool InitHeadless(int w, int h, const char* title);
+
 		bool isGLFWInitialized;
 		bool isInitialized;
 		GLFWwindow* window;
 		GamePad gamepad;
+		ContextType contextType = ContextType::Window;
+		std::chrono::steady_clock::time_point startTime; ///< InitĂяo.
 	};
 } // namespace GLFWEW 
 
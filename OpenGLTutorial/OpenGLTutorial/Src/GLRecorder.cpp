@@ -0,0 +1,770 @@
+/**
+* @file GLRecorder.cpp
+*/
+#define GLRECORDER_NO_REDIRECT
+#include "GLRecorder.h"
+#include "GLState.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <unordered_map>
+#include <initializer_list>
+#include <iterator>
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace GLRecorder {
+
+	namespace /* unnamed */ {
+
+		/// g[Xt@C̐擪s.
+		const char traceHeader[] = "# GLRecorder trace 1";
+
+		/**
+		* g[Xɏo.
+		*/
+		struct Arg {
+			enum Type { Int, Float, Data };
+			Type type;
+			long long i;
+			double f;
+			const void* data;
+			size_t size;
+		};
+		Arg I(long long v) { return { Arg::Int, v, 0, nullptr, 0 }; }
+		Arg F(double v) { return { Arg::Float, 0, v, nullptr, 0 }; }
+		Arg P(const void* p) { return I(static_cast<long long>(reinterpret_cast<uintptr_t>(p))); }
+		Arg D(const void* p, size_t size) { return p ? Arg{ Arg::Data, 0, 0, p, size } : I(0); }
+
+		/**
+		* ݗpɃ}bvĂobt@͈̔.
+		*/
+		struct MappedRange {
+			GLenum target;
+			GLuint buffer;
+			GLintptr offset;
+			GLsizeiptr length;
+			const void* pointer;
+		};
+
+		bool isEnabled = false;
+		bool isInFrame = false;
+		Stats frameStats; ///< L^̃t[̓v.
+		Stats lastStats; ///< ŌɋL^It[̓v.
+
+		std::string captureFilename; ///< o\̃g[Xt@C. Ȃ珑oȂ.
+		int captureSkipCount = 0; ///< on߂܂łɔ΂t[.
+		bool isCapturing = false;
+		std::ofstream traceFile;
+		std::ofstream dataFile; ///< ]f[^i[t@C.
+		size_t dataOffset = 0;
+		size_t traceCallCount = 0;
+		std::vector<MappedRange> mappedList;
+
+		/// uOGLEW̊֐|C^.
+		PFNGLBINDBUFFERPROC realBindBuffer;
+		PFNGLBINDBUFFERBASEPROC realBindBufferBase;
+		PFNGLBINDBUFFERRANGEPROC realBindBufferRange;
+		PFNGLBINDVERTEXARRAYPROC realBindVertexArray;
+		PFNGLUSEPROGRAMPROC realUseProgram;
+		PFNGLACTIVETEXTUREPROC realActiveTexture;
+		PFNGLBINDFRAMEBUFFERPROC realBindFramebuffer;
+		PFNGLBUFFERDATAPROC realBufferData;
+		PFNGLBUFFERSUBDATAPROC realBufferSubData;
+		PFNGLMAPBUFFERRANGEPROC realMapBufferRange;
+		PFNGLUNMAPBUFFERPROC realUnmapBuffer;
+		PFNGLUNIFORM2FPROC realUniform2f;
+		PFNGLUNIFORM1IVPROC realUniform1iv;
+		PFNGLUNIFORMMATRIX4FVPROC realUniformMatrix4fv;
+		PFNGLDRAWELEMENTSBASEVERTEXPROC realDrawElementsBaseVertex;
+		PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC realDrawElementsInstancedBaseVertex;
+		PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC realDrawElementsInstancedBaseVertexBaseInstance;
+		PFNGLMULTIDRAWELEMENTSINDIRECTPROC realMultiDrawElementsIndirect;
+		PFNGLBEGINQUERYPROC realBeginQuery;
+		PFNGLENDQUERYPROC realEndQuery;
+		PFNGLQUERYCOUNTERPROC realQueryCounter;
+		PFNGLGETQUERYOBJECTUIVPROC realGetQueryObjectuiv;
+		PFNGLGETQUERYOBJECTUI64VPROC realGetQueryObjectui64v;
+		PFNGLFENCESYNCPROC realFenceSync;
+		PFNGLCLIENTWAITSYNCPROC realClientWaitSync;
+		PFNGLDELETESYNCPROC realDeleteSync;
+
+		/**
+		* Ăяo𐔂.
+		*
+		* @param category Ăяo̎.
+		*/
+		void Count(Category category){
+			if (isInFrame) {
+				++frameStats.callCount[category];
+				++frameStats.totalCallCount;
+			}
+		}
+
+		/**
+		* Ăяo𐔂AoȂg[Xɒǉ.
+		*
+		* @param category Ăяo̎.
+		* @param name     ֐.
+		* @param args     .
+		*/
+		void Record(Category category, const char* name, std::initializer_list<Arg> args){
+			Count(category);
+			if (!isCapturing) {
+				return;
+			}
+			traceFile << name;
+			for (const Arg& e : args) {
+				switch (e.type) {
+				case Arg::Int:
+					traceFile << ' ' << e.i;
+					break;
+				case Arg::Float:
+					traceFile << " f" << std::setprecision(17) << e.f;
+					break;
+				case Arg::Data:
+					traceFile << " @" << dataOffset << ':' << e.size;
+					dataFile.write(static_cast<const char*>(e.data), e.size);
+					dataOffset += e.size;
+					break;
+				}
+			}
+			traceFile << '\n';
+			++traceCallCount;
+		}
+
+		/**
+		* obt@̎ނɊ蓖ĂĂobt@擾.
+		*
+		* @param target obt@̎.
+		*
+		* @return 蓖ĂĂobt@ID. ΉĂȂނȂ0.
+		*/
+		GLuint BoundBuffer(GLenum target){
+			static const struct {
+				GLenum target;
+				GLenum binding;
+			} bindingList[] = {
+				{ GL_ARRAY_BUFFER, GL_ARRAY_BUFFER_BINDING },
+				{ GL_ELEMENT_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER_BINDING },
+				{ GL_UNIFORM_BUFFER, GL_UNIFORM_BUFFER_BINDING },
+				{ GL_SHADER_STORAGE_BUFFER, GL_SHADER_STORAGE_BUFFER_BINDING },
+				{ GL_DRAW_INDIRECT_BUFFER, GL_DRAW_INDIRECT_BUFFER_BINDING },
+				{ GL_TEXTURE_BUFFER, GL_TEXTURE_BUFFER_BINDING },
+				{ GL_COPY_READ_BUFFER, GL_COPY_READ_BUFFER_BINDING },
+				{ GL_COPY_WRITE_BUFFER, GL_COPY_WRITE_BUFFER_BINDING },
+			};
+			for (const auto& e : bindingList) {
+				if (e.target == target) {
+					GLint buffer = 0;
+					glGetIntegerv(e.binding, &buffer);
+					return static_cast<GLuint>(buffer);
+				}
+			}
+			return 0;
+		}
+
+		void GLAPIENTRY HookBindBuffer(GLenum target, GLuint buffer){
+			Record(Category_Bind, "glBindBuffer", { I(target), I(buffer) });
+			realBindBuffer(target, buffer);
+		}
+
+		void GLAPIENTRY HookBindBufferBase(GLenum target, GLuint index, GLuint buffer){
+			Record(Category_Bind, "glBindBufferBase", { I(target), I(index), I(buffer) });
+			realBindBufferBase(target, index, buffer);
+		}
+
+		void GLAPIENTRY HookBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size){
+			Record(Category_Bind, "glBindBufferRange", { I(target), I(index), I(buffer), I(offset), I(size) });
+			realBindBufferRange(target, index, buffer, offset, size);
+		}
+
+		void GLAPIENTRY HookBindVertexArray(GLuint array){
+			Record(Category_Bind, "glBindVertexArray", { I(array) });
+			realBindVertexArray(array);
+		}
+
+		void GLAPIENTRY HookUseProgram(GLuint program){
+			Record(Category_Bind, "glUseProgram", { I(program) });
+			realUseProgram(program);
+		}
+
+		void GLAPIENTRY HookActiveTexture(GLenum texture){
+			Record(Category_Bind, "glActiveTexture", { I(texture) });
+			realActiveTexture(texture);
+		}
+
+		void GLAPIENTRY HookBindFramebuffer(GLenum target, GLuint framebuffer){
+			Record(Category_Bind, "glBindFramebuffer", { I(target), I(framebuffer) });
+			realBindFramebuffer(target, framebuffer);
+		}
+
+		void GLAPIENTRY HookBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage){
+			if (isInFrame) {
+				frameStats.uploadBytes += data ? size : 0;
+			}
+			Record(Category_Upload, "glBufferData", { I(target), I(size), D(data, size), I(usage) });
+			realBufferData(target, size, data, usage);
+		}
+
+		void GLAPIENTRY HookBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data){
+			if (isInFrame) {
+				frameStats.uploadBytes += size;
+			}
+			Record(Category_Upload, "glBufferSubData", { I(target), I(offset), I(size), D(data, size) });
+			realBufferSubData(target, offset, size, data);
+		}
+
+		/**
+		* }bv̓g[XɏoA}bvƂɏ܂ꂽe glBufferWrite Ƃďo.
+		*/
+		void* GLAPIENTRY HookMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access){
+			void* p = realMapBufferRange(target, offset, length, access);
+			Count(Category_Upload);
+			if (isInFrame && (access & GL_MAP_WRITE_BIT)) {
+				frameStats.uploadBytes += length;
+			}
+			if (isCapturing && p && (access & GL_MAP_WRITE_BIT) && !(access & GL_MAP_PERSISTENT_BIT)) {
+				mappedList.push_back({ target, BoundBuffer(target), offset, length, p });
+			}
+			return p;
+		}
+
+		GLboolean GLAPIENTRY HookUnmapBuffer(GLenum target){
+			Count(Category_Upload);
+			for (auto itr = mappedList.rbegin(); itr != mappedList.rend(); ++itr) {
+				if (itr->target == target) {
+					Record(Category_Upload, "glBufferWrite",
+						{ I(itr->buffer), I(itr->offset), I(itr->length), D(itr->pointer, itr->length) });
+					--frameStats.callCount[Category_Upload]; // ̂̓}bv̉1񂾂ɂ.
+					--frameStats.totalCallCount;
+					mappedList.erase(std::next(itr).base());
+					break;
+				}
+			}
+			return realUnmapBuffer(target);
+		}
+
+		void GLAPIENTRY HookUniform2f(GLint location, GLfloat v0, GLfloat v1){
+			Record(Category_Uniform, "glUniform2f", { I(location), F(v0), F(v1) });
+			realUniform2f(location, v0, v1);
+		}
+
+		void GLAPIENTRY HookUniform1iv(GLint location, GLsizei count, const GLint* value){
+			Record(Category_Uniform, "glUniform1iv", { I(location), I(count), D(value, count * sizeof(GLint)) });
+			realUniform1iv(location, count, value);
+		}
+
+		void GLAPIENTRY HookUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value){
+			Record(Category_Uniform, "glUniformMatrix4fv",
+				{ I(location), I(count), I(transpose), D(value, count * 16 * sizeof(GLfloat)) });
+			realUniformMatrix4fv(location, count, transpose, value);
+		}
+
+		void GLAPIENTRY HookDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex){
+			if (isInFrame) {
+				frameStats.drawIndexCount += count;
+			}
+			Record(Category_Draw, "glDrawElementsBaseVertex", { I(mode), I(count), I(type), P(indices), I(basevertex) });
+			realDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+		}
+
+		void GLAPIENTRY HookDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices,
+			GLsizei instancecount, GLint basevertex){
+			if (isInFrame) {
+				frameStats.drawIndexCount += count * instancecount;
+			}
+			Record(Category_Draw, "glDrawElementsInstancedBaseVertex",
+				{ I(mode), I(count), I(type), P(indices), I(instancecount), I(basevertex) });
+			realDrawElementsInstancedBaseVertex(mode, count, type, indices, instancecount, basevertex);
+		}
+
+		void GLAPIENTRY HookDrawElementsInstancedBaseVertexBaseInstance(GLenum mode, GLsizei count, GLenum type,
+			const void* indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance){
+			if (isInFrame) {
+				frameStats.drawIndexCount += count * instancecount;
+			}
+			Record(Category_Draw, "glDrawElementsInstancedBaseVertexBaseInstance",
+				{ I(mode), I(count), I(type), P(indices), I(instancecount), I(basevertex), I(baseinstance) });
+			realDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instancecount, basevertex, baseinstance);
+		}
+
+		void GLAPIENTRY HookMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride){
+			Record(Category_Draw, "glMultiDrawElementsIndirect", { I(mode), I(type), P(indirect), I(drawcount), I(stride) });
+			realMultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+		}
+
+		// NGƃtFX͕`挋ʂɉeȂ̂ŁA邾Ńg[Xɂ͏oȂ.
+
+		void GLAPIENTRY HookBeginQuery(GLenum target, GLuint id){
+			Count(Category_Query);
+			realBeginQuery(target, id);
+		}
+
+		void GLAPIENTRY HookEndQuery(GLenum target){
+			Count(Category_Query);
+			realEndQuery(target);
+		}
+
+		void GLAPIENTRY HookQueryCounter(GLuint id, GLenum target){
+			Count(Category_Query);
+			realQueryCounter(id, target);
+		}
+
+		void GLAPIENTRY HookGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params){
+			Count(Category_Query);
+			realGetQueryObjectuiv(id, pname, params);
+		}
+
+		void GLAPIENTRY HookGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params){
+			Count(Category_Query);
+			realGetQueryObjectui64v(id, pname, params);
+		}
+
+		GLsync GLAPIENTRY HookFenceSync(GLenum condition, GLbitfield flags){
+			Count(Category_Query);
+			return realFenceSync(condition, flags);
+		}
+
+		GLenum GLAPIENTRY HookClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout){
+			Count(Category_Query);
+			return realClientWaitSync(sync, flags, timeout);
+		}
+
+		void GLAPIENTRY HookDeleteSync(GLsync sync){
+			Count(Category_Query);
+			realDeleteSync(sync);
+		}
+
+		/**
+		* g[Ẍ.
+		*/
+		struct ReplayArg {
+			long long i = 0;
+			double f = 0;
+			const void* data = nullptr;
+		};
+
+		/// ̈obt@̃ItZbg\|C^ɕϊ.
+		const void* Offset(const ReplayArg& arg) {
+			return reinterpret_cast<const void*>(static_cast<uintptr_t>(arg.i));
+		}
+
+		/**
+		* obt@̈ꕔ.
+		*
+		* @param buffer obt@ID.
+		* @param offset ͈͂̃oCgItZbg.
+		* @param size   oCg.
+		* @param data   ރf[^.
+		*
+		* ύXłȂ̈(glBufferStorage)̃obt@ɂ߂悤ɁAꎞobt@Rs[.
+		*/
+		void BufferWrite(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data){
+			GLuint staging = 0;
+			glGenBuffers(1, &staging);
+			glBindBuffer(GL_COPY_READ_BUFFER, staging);
+			glBufferData(GL_COPY_READ_BUFFER, size, data, GL_STREAM_COPY);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, offset, size);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			glDeleteBuffers(1, &staging);
+		}
+
+		/// g[X̊֐ƁÅ֐Ďs֐̑Ή\.
+		typedef std::function<void(const std::vector<ReplayArg>&)> ReplayFunc;
+		const std::unordered_map<std::string, std::pair<size_t, ReplayFunc>>& ReplayFuncMap(){
+			typedef std::vector<ReplayArg> A;
+			static const std::unordered_map<std::string, std::pair<size_t, ReplayFunc>> funcMap = {
+				{ "glBindBuffer", { 2, [](const A& a) { glBindBuffer(a[0].i, a[1].i); } } },
+				{ "glBindBufferBase", { 3, [](const A& a) { glBindBufferBase(a[0].i, a[1].i, a[2].i); } } },
+				{ "glBindBufferRange", { 5, [](const A& a) { glBindBufferRange(a[0].i, a[1].i, a[2].i, a[3].i, a[4].i); } } },
+				{ "glBindVertexArray", { 1, [](const A& a) { glBindVertexArray(a[0].i); } } },
+				{ "glUseProgram", { 1, [](const A& a) { glUseProgram(a[0].i); } } },
+				{ "glActiveTexture", { 1, [](const A& a) { glActiveTexture(a[0].i); } } },
+				{ "glBindFramebuffer", { 2, [](const A& a) { glBindFramebuffer(a[0].i, a[1].i); } } },
+				{ "glBindTexture", { 2, [](const A& a) { glBindTexture(a[0].i, a[1].i); } } },
+				{ "glBufferData", { 4, [](const A& a) { glBufferData(a[0].i, a[1].i, a[2].data, a[3].i); } } },
+				{ "glBufferSubData", { 4, [](const A& a) { glBufferSubData(a[0].i, a[1].i, a[2].i, a[3].data); } } },
+				{ "glBufferWrite", { 4, [](const A& a) { BufferWrite(a[0].i, a[1].i, a[2].i, a[3].data); } } },
+				{ "glUniform2f", { 3, [](const A& a) {
+					glUniform2f(a[0].i, static_cast<GLfloat>(a[1].f), static_cast<GLfloat>(a[2].f)); } } },
+				{ "glUniform1iv", { 3, [](const A& a) {
+					glUniform1iv(a[0].i, a[1].i, static_cast<const GLint*>(a[2].data)); } } },
+				{ "glUniformMatrix4fv", { 4, [](const A& a) {
+					glUniformMatrix4fv(a[0].i, a[1].i, a[2].i, static_cast<const GLfloat*>(a[3].data)); } } },
+				{ "glDrawElements", { 4, [](const A& a) { glDrawElements(a[0].i, a[1].i, a[2].i, Offset(a[3])); } } },
+				{ "glDrawElementsBaseVertex", { 5, [](const A& a) {
+					glDrawElementsBaseVertex(a[0].i, a[1].i, a[2].i, Offset(a[3]), a[4].i); } } },
+				{ "glDrawElementsInstancedBaseVertex", { 6, [](const A& a) {
+					glDrawElementsInstancedBaseVertex(a[0].i, a[1].i, a[2].i, Offset(a[3]), a[4].i, a[5].i); } } },
+				{ "glDrawElementsInstancedBaseVertexBaseInstance", { 7, [](const A& a) {
+					glDrawElementsInstancedBaseVertexBaseInstance(a[0].i, a[1].i, a[2].i, Offset(a[3]), a[4].i, a[5].i, a[6].i); } } },
+				{ "glMultiDrawElementsIndirect", { 5, [](const A& a) {
+					glMultiDrawElementsIndirect(a[0].i, a[1].i, Offset(a[2]), a[3].i, a[4].i); } } },
+				{ "glViewport", { 4, [](const A& a) { glViewport(a[0].i, a[1].i, a[2].i, a[3].i); } } },
+				{ "glScissor", { 4, [](const A& a) { glScissor(a[0].i, a[1].i, a[2].i, a[3].i); } } },
+				{ "glEnable", { 1, [](const A& a) { glEnable(a[0].i); } } },
+				{ "glDisable", { 1, [](const A& a) { glDisable(a[0].i); } } },
+				{ "glBlendFunc", { 2, [](const A& a) { glBlendFunc(a[0].i, a[1].i); } } },
+				{ "glDepthMask", { 1, [](const A& a) { glDepthMask(static_cast<GLboolean>(a[0].i)); } } },
+				{ "glDepthFunc", { 1, [](const A& a) { glDepthFunc(a[0].i); } } },
+				{ "glDepthRange", { 2, [](const A& a) { glDepthRange(a[0].f, a[1].f); } } },
+				{ "glClear", { 1, [](const A& a) { glClear(a[0].i); } } },
+				{ "glClearColor", { 4, [](const A& a) {
+					glClearColor(static_cast<GLclampf>(a[0].f), static_cast<GLclampf>(a[1].f),
+						static_cast<GLclampf>(a[2].f), static_cast<GLclampf>(a[3].f)); } } },
+				{ "glClearDepth", { 1, [](const A& a) { glClearDepth(a[0].f); } } },
+			};
+			return funcMap;
+		}
+
+	} // unnamed namespace
+
+	/**
+	* GLEW̊֐|C^L^p̊֐ɒu.
+	*
+	* @retval true  L^Jn.
+	* @retval false ɋL^Ă.
+	*
+	* GLEW̏ɌĂяo. u֐͌ɖ߂Ȃ.
+	*/
+	bool Enable(){
+		if (isEnabled) {
+			return false;
+		}
+#define GLRECORDER_HOOK(name) real##name = __glew##name; __glew##name = Hook##name;
+		GLRECORDER_HOOK(BindBuffer);
+		GLRECORDER_HOOK(BindBufferBase);
+		GLRECORDER_HOOK(BindBufferRange);
+		GLRECORDER_HOOK(BindVertexArray);
+		GLRECORDER_HOOK(UseProgram);
+		GLRECORDER_HOOK(ActiveTexture);
+		GLRECORDER_HOOK(BindFramebuffer);
+		GLRECORDER_HOOK(BufferData);
+		GLRECORDER_HOOK(BufferSubData);
+		GLRECORDER_HOOK(MapBufferRange);
+		GLRECORDER_HOOK(UnmapBuffer);
+		GLRECORDER_HOOK(Uniform2f);
+		GLRECORDER_HOOK(Uniform1iv);
+		GLRECORDER_HOOK(UniformMatrix4fv);
+		GLRECORDER_HOOK(DrawElementsBaseVertex);
+		GLRECORDER_HOOK(DrawElementsInstancedBaseVertex);
+		GLRECORDER_HOOK(DrawElementsInstancedBaseVertexBaseInstance);
+		GLRECORDER_HOOK(MultiDrawElementsIndirect);
+		GLRECORDER_HOOK(BeginQuery);
+		GLRECORDER_HOOK(EndQuery);
+		GLRECORDER_HOOK(QueryCounter);
+		GLRECORDER_HOOK(GetQueryObjectuiv);
+		GLRECORDER_HOOK(GetQueryObjectui64v);
+		GLRECORDER_HOOK(FenceSync);
+		GLRECORDER_HOOK(ClientWaitSync);
+		GLRECORDER_HOOK(DeleteSync);
+#undef GLRECORDER_HOOK
+		isEnabled = true;
+		return true;
+	}
+
+	/**
+	* L^Lׂ.
+	*
+	* @retval true  L.
+	* @retval false .
+	*/
+	bool IsEnabled(){
+		return isEnabled;
+	}
+
+	/**
+	* t[̋L^Jn.
+	*
+	* g[Xot[ł́AGLStateL^ĂԂsɂāA
+	* t[ŎgԂSăg[XɊ܂܂悤ɂ.
+	*/
+	void BeginFrame(){
+		if (!isEnabled) {
+			return;
+		}
+		frameStats = Stats();
+		isInFrame = true;
+		if (captureFilename.empty()) {
+			return;
+		}
+		if (captureSkipCount > 0) {
+			--captureSkipCount;
+			return;
+		}
+		traceFile.open(captureFilename, std::ios::out | std::ios::trunc);
+		dataFile.open(captureFilename + ".bin", std::ios::out | std::ios::trunc | std::ios::binary);
+		if (!traceFile || !dataFile) {
+			std::cerr << "ERROR: g[Xt@C'" << captureFilename << "'쐬ł܂" << std::endl;
+			traceFile.close();
+			dataFile.close();
+			captureFilename.clear();
+			return;
+		}
+		traceFile << traceHeader << '\n';
+		dataOffset = 0;
+		traceCallCount = 0;
+		mappedList.clear();
+		isCapturing = true;
+		GLState::Reset();
+	}
+
+	/**
+	* t[̋L^I.
+	*
+	* L^v FrameStats() Ŏ擾ł.
+	*/
+	void EndFrame(){
+		if (!isInFrame) {
+			return;
+		}
+		lastStats = frameStats;
+		isInFrame = false;
+		if (isCapturing) {
+			traceFile.close();
+			dataFile.close();
+			isCapturing = false;
+			std::cout << "GLRecorder: " << captureFilename << "" << traceCallCount << "̌Ăяo(" <<
+				dataOffset << "oCg̃f[^)o܂" << std::endl;
+			captureFilename.clear();
+		}
+	}
+
+	/**
+	* ŌɋL^It[̓v擾.
+	*
+	* @return Ăяo̓v.
+	*/
+	const Stats& FrameStats(){
+		return lastStats;
+	}
+
+	/**
+	* Ăяo̎ނ̖O擾.
+	*
+	* @param category Ăяo̎.
+	*
+	* @return ނ̖O.
+	*/
+	const char* CategoryName(Category category){
+		static const char* const nameList[] = { "draw", "bind", "state", "upload", "uniform", "clear", "query" };
+		static_assert(sizeof(nameList) / sizeof(nameList[0]) == Category_Count, "nameList̗vf܂");
+		return category < Category_Count ? nameList[category] : "unknown";
+	}
+
+	/**
+	* 1t[̌Ăяot@Cɏo.
+	*
+	* @param filename       g[Xt@C. ]f[^ filename ".bin"tt@Cɏo.
+	* @param skipFrameCount o܂łɔ΂t[.
+	*
+	* @retval true  o\񂵂.
+	* @retval false L^LłȂ.
+	*/
+	bool CaptureFrame(const char* filename, int skipFrameCount){
+		if (!isEnabled) {
+			std::cerr << "ERROR: GLRecorderLɂȂĂ܂" << std::endl;
+			return false;
+		}
+		captureFilename = filename;
+		captureSkipCount = skipFrameCount;
+		return true;
+	}
+
+	/**
+	* g[Xt@ČĂяoĎs.
+	*
+	* @param filename CaptureFrame ŏog[Xt@C.
+	*
+	* @retval true  Ďs.
+	* @retval false t@Cǂ߂ȂA܂͑ΉĂȂĂяo.
+	*
+	* g[Xɂ̓IuWFNg̍쐬܂܂Ȃ̂ŁAL^ƂƓ菇Ŏ쐬ĂĂяo.
+	* ĎsGLStateL^ĂԂƎۂ̏ԂقȂ̂ŁAGLState::Reset Ăяo.
+	*/
+	bool Replay(const char* filename){
+		std::ifstream trace(filename);
+		std::ifstream dataStream(std::string(filename) + ".bin", std::ios::binary);
+		if (!trace || !dataStream) {
+			std::cerr << "ERROR: g[Xt@C'" << filename << "'ǂݍ߂܂" << std::endl;
+			return false;
+		}
+		const std::vector<char> data((std::istreambuf_iterator<char>(dataStream)), std::istreambuf_iterator<char>());
+		std::string line;
+		if (!std::getline(trace, line) || line != traceHeader) {
+			std::cerr << "ERROR: '" << filename << "'̓g[Xt@Cł͂܂" << std::endl;
+			return false;
+		}
+		const auto& funcMap = ReplayFuncMap();
+		std::vector<ReplayArg> args;
+		size_t callCount = 0;
+		for (int lineNo = 2; std::getline(trace, line); ++lineNo) {
+			std::istringstream ss(line);
+			std::string name;
+			ss >> name;
+			const auto itr = funcMap.find(name);
+			if (itr == funcMap.end()) {
+				std::cerr << "ERROR: " << filename << '(' << lineNo << "): ΉĂȂ֐'" << name << "'" << std::endl;
+				GLState::Reset();
+				return false;
+			}
+			args.clear();
+			std::string token;
+			while (ss >> token) {
+				ReplayArg arg;
+				if (token[0] == 'f') {
+					arg.f = strtod(token.c_str() + 1, nullptr);
+				} else if (token[0] == '@') {
+					char* end = nullptr;
+					const size_t offset = strtoull(token.c_str() + 1, &end, 10);
+					const size_t size = strtoull(end + 1, nullptr, 10);
+					if (offset + size > data.size()) {
+						std::cerr << "ERROR: " << filename << '(' << lineNo << "): f[^͈̔͂sł" << std::endl;
+						GLState::Reset();
+						return false;
+					}
+					arg.data = data.data() + offset;
+				} else {
+					arg.i = strtoll(token.c_str(), nullptr, 10);
+				}
+				args.push_back(arg);
+			}
+			if (args.size() != itr->second.first) {
+				std::cerr << "ERROR: " << filename << '(' << lineNo << "): '" << name << "'̈̐sł" << std::endl;
+				GLState::Reset();
+				return false;
+			}
+			itr->second.second(args);
+			++callCount;
+		}
+		GLState::Reset();
+		std::cout << "GLRecorder: " << filename << "" << callCount << "̌ĂяoĎs܂" << std::endl;
+		return true;
+	}
+
+	/**
+	* iIɃ}bvobt@ւ݂̏L^.
+	*
+	* @param buffer obt@ID.
+	* @param offset 񂾔͈͂̃oCgItZbg.
+	* @param size   񂾃oCg.
+	* @param data   񂾃f[^(}bvł悢).
+	*
+	* OpenGL̊֐oRȂ݂͋L^łȂ̂ŁA񂾑Ăяo.
+	*/
+	void PersistentWrite(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data){
+		if (!isEnabled) {
+			return;
+		}
+		if (isInFrame) {
+			frameStats.persistentWriteBytes += size;
+		}
+		Record(Category_Upload, "glBufferWrite", { I(buffer), I(offset), I(size), D(data, size) });
+	}
+
+	namespace Wrap {
+
+		void GLAPIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices){
+			if (isEnabled) {
+				if (isInFrame) {
+					frameStats.drawIndexCount += count;
+				}
+				Record(Category_Draw, "glDrawElements", { I(mode), I(count), I(type), P(indices) });
+			}
+			::glDrawElements(mode, count, type, indices);
+		}
+
+		void GLAPIENTRY glBindTexture(GLenum target, GLuint texture){
+			if (isEnabled) {
+				Record(Category_Bind, "glBindTexture", { I(target), I(texture) });
+			}
+			::glBindTexture(target, texture);
+		}
+
+		void GLAPIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height){
+			if (isEnabled) {
+				Record(Category_State, "glViewport", { I(x), I(y), I(width), I(height) });
+			}
+			::glViewport(x, y, width, height);
+		}
+
+		void GLAPIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height){
+			if (isEnabled) {
+				Record(Category_State, "glScissor", { I(x), I(y), I(width), I(height) });
+			}
+			::glScissor(x, y, width, height);
+		}
+
+		void GLAPIENTRY glEnable(GLenum cap){
+			if (isEnabled) {
+				Record(Category_State, "glEnable", { I(cap) });
+			}
+			::glEnable(cap);
+		}
+
+		void GLAPIENTRY glDisable(GLenum cap){
+			if (isEnabled) {
+				Record(Category_State, "glDisable", { I(cap) });
+			}
+			::glDisable(cap);
+		}
+
+		void GLAPIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor){
+			if (isEnabled) {
+				Record(Category_State, "glBlendFunc", { I(sfactor), I(dfactor) });
+			}
+			::glBlendFunc(sfactor, dfactor);
+		}
+
+		void GLAPIENTRY glDepthMask(GLboolean flag){
+			if (isEnabled) {
+				Record(Category_State, "glDepthMask", { I(flag) });
+			}
+			::glDepthMask(flag);
+		}
+
+		void GLAPIENTRY glDepthFunc(GLenum func){
+			if (isEnabled) {
+				Record(Category_State, "glDepthFunc", { I(func) });
+			}
+			::glDepthFunc(func);
+		}
+
+		void GLAPIENTRY glDepthRange(GLclampd zNear, GLclampd zFar){
+			if (isEnabled) {
+				Record(Category_State, "glDepthRange", { F(zNear), F(zFar) });
+			}
+			::glDepthRange(zNear, zFar);
+		}
+
+		void GLAPIENTRY glClear(GLbitfield mask){
+			if (isEnabled) {
+				Record(Category_Clear, "glClear", { I(mask) });
+			}
+			::glClear(mask);
+		}
+
+		void GLAPIENTRY glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha){
+			if (isEnabled) {
+				Record(Category_Clear, "glClearColor", { F(red), F(green), F(blue), F(alpha) });
+			}
+			::glClearColor(red, green, blue, alpha);
+		}
+
+		void GLAPIENTRY glClearDepth(GLclampd depth){
+			if (isEnabled) {
+				Record(Category_Clear, "glClearDepth", { F(depth) });
+			}
+			::glClearDepth(depth);
+		}
+
+	} // namespace Wrap
+
+} // namespace GLRecorder
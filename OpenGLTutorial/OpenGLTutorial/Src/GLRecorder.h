@@ -0,0 +1,95 @@
+/**
+* @file GLRecorder.h
+*/
+#ifndef GLRECORDER_H_INCLUDED
+#define GLRECORDER_H_INCLUDED
+#include <GL/glew.h>
+#include <stddef.h>
+
+/**
+* GWgOpenGL̊֐ĂяoL^邽߂̖O.
+*
+* Enable ĂяoƁAGLEW̊֐|C^L^p̊֐ɒuA
+* BeginFrame  EndFrame ܂ł̌Ăяo̐ނƂɐ.
+* GLEWoRȂOpenGL 1.1̊֐́Ãwb_CN[ht@CL^̑ΏۂɂȂ.
+* CaptureFrame w肷ƁA1t[̌Ăяo Replay ōĎsł`Ńt@Cɏo.
+*
+* GLRECORDER_ENABLED `ărhꍇ GameEngine::Init ŎIɗLɂȂ.
+*/
+namespace GLRecorder {
+
+	/**
+	* Ăяo̎.
+	*/
+	enum Category {
+		Category_Draw, ///< `施.
+		Category_Bind, ///< VF[_AVAOAeNX`Aobt@At[obt@̊蓖.
+		Category_State, ///< r[|[gA[xeXgAuhȂǂ̏ԕύX.
+		Category_Upload, ///< obt@ւ̓]ƃ}bv.
+		Category_Uniform, ///< jtH[ϐ̐ݒ.
+		Category_Clear, ///< obt@̃NA.
+		Category_Query, ///< NGƃtFX.
+		Category_Count,
+	};
+
+	/**
+	* 1t[̌Ăяo̓v.
+	*/
+	struct Stats {
+		size_t callCount[Category_Count] = {}; ///< ނƂ̌Ăяo.
+		size_t totalCallCount = 0; ///< Ăяo񐔂̍v.
+		size_t drawIndexCount = 0; ///< `施߂ŕ`悵CfbNX(CX^X|. Ԑڕ`).
+		size_t uploadBytes = 0; ///< ]܂̓}bvŏݗpɊmۂoCg.
+		size_t persistentWriteBytes = 0; ///< iIɃ}bvobt@ɏ񂾃oCg.
+	};
+
+	bool Enable();
+	bool IsEnabled();
+	void BeginFrame();
+	void EndFrame();
+	const Stats& FrameStats();
+	const char* CategoryName(Category category);
+	bool CaptureFrame(const char* filename, int skipFrameCount = 0);
+	bool Replay(const char* filename);
+	void PersistentWrite(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data);
+
+	/**
+	* GLEWoRȂOpenGL 1.1̊֐̋L^p̊֐.
+	*
+	* ̃}NɂāAOpenGL̊֐̑ɌĂяo.
+	*/
+	namespace Wrap {
+		void GLAPIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+		void GLAPIENTRY glBindTexture(GLenum target, GLuint texture);
+		void GLAPIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+		void GLAPIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+		void GLAPIENTRY glEnable(GLenum cap);
+		void GLAPIENTRY glDisable(GLenum cap);
+		void GLAPIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor);
+		void GLAPIENTRY glDepthMask(GLboolean flag);
+		void GLAPIENTRY glDepthFunc(GLenum func);
+		void GLAPIENTRY glDepthRange(GLclampd zNear, GLclampd zFar);
+		void GLAPIENTRY glClear(GLbitfield mask);
+		void GLAPIENTRY glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+		void GLAPIENTRY glClearDepth(GLclampd depth);
+	} // namespace Wrap
+
+} // namespace GLRecorder
+
+#ifndef GLRECORDER_NO_REDIRECT
+#define glDrawElements GLRecorder::Wrap::glDrawElements
+#define glBindTexture GLRecorder::Wrap::glBindTexture
+#define glViewport GLRecorder::Wrap::glViewport
+#define glScissor GLRecorder::Wrap::glScissor
+#define glEnable GLRecorder::Wrap::glEnable
+#define glDisable GLRecorder::Wrap::glDisable
+#define glBlendFunc GLRecorder::Wrap::glBlendFunc
+#define glDepthMask GLRecorder::Wrap::glDepthMask
+#define glDepthFunc GLRecorder::Wrap::glDepthFunc
+#define glDepthRange GLRecorder::Wrap::glDepthRange
+#define glClear GLRecorder::Wrap::glClear
+#define glClearColor GLRecorder::Wrap::glClearColor
+#define glClearDepth GLRecorder::Wrap::glClearDepth
+#endif // GLRECORDER_NO_REDIRECT
+
+#endif // GLRECORDER_H_INCLUDED
@@ -0,0 +1,409 @@
+/**
+* @file GLState.cpp
+*/
+#include "GLState.h"
+#include "GLRecorder.h"
+#include <algorithm>
+
+namespace GLState {
+
+	namespace /* unnamed */ {
+
+		/// sȏԂ\l. ŏ̕ύX͕Ks.
+		const GLuint unknownId = ~0U;
+		const GLenum unknownEnum = ~0U;
+
+		/// L^eNX`EC[WEjbg̐.
+		const GLuint maxTextureUnitCount = 16;
+		/// L^CfbNXtobt@̃oCfBOE|Cg̐.
+		const GLuint maxIndexedBindingCount = 16;
+
+		/// CfbNXtobt@̃oCfBOE|Cg̏.
+		struct IndexedBinding {
+			GLuint buffer;
+			GLintptr offset;
+			GLsizeiptr size; ///< BindBufferBaseŊ蓖ĂƂ-1.
+		};
+
+		/// L^ĂOpenGL̏.
+		struct State {
+			GLuint program;
+			GLuint vao;
+			GLuint activeTexture;
+			GLenum textureTarget[maxTextureUnitCount];
+			GLuint texture[maxTextureUnitCount];
+			IndexedBinding uniformBuffer[maxIndexedBindingCount];
+			IndexedBinding storageBuffer[maxIndexedBindingCount];
+			GLuint framebuffer;
+			GLint viewport[4];
+			GLint scissor[4];
+			int depthTest; ///< -1͕s.
+			int cullFace;
+			int blend;
+			int scissorTest;
+			GLenum blendSrc;
+			GLenum blendDst;
+			int depthMask; ///< -1͕s.
+			GLenum depthFunc;
+			GLclampd depthRange[2]; ///< ̒l͕s.
+		};
+
+		State state;
+		Stats stats;
+		bool isInitialized = false;
+
+		/**
+		* Ԃ̋L^JnĂȂΊJn.
+		*/
+		void InitOnce(){
+			if (!isInitialized) {
+				Reset();
+			}
+		}
+
+		/**
+		* ԕύX̔sƏȗL^.
+		*
+		* @param issued strue, ȗfalse.
+		*
+		* @return issued̂܂ܕԂ.
+		*/
+		bool Count(bool issued){
+			if (issued) {
+				++stats.issuedCount;
+			} else {
+				++stats.elidedCount;
+			}
+			return issued;
+		}
+
+		/**
+		* CfbNXtobt@̃oCfBOE|Cg̋L^擾.
+		*
+		* @param target GL_UNIFORM_BUFFER ܂ GL_SHADER_STORAGE_BUFFER.
+		* @param index  oCfBOE|Cg.
+		*
+		* @return L^ւ̃|C^. L^ΏۊOȂnullptr.
+		*/
+		IndexedBinding* GetIndexedBinding(GLenum target, GLuint index){
+			if (index >= maxIndexedBindingCount) {
+				return nullptr;
+			}
+			switch (target) {
+			case GL_UNIFORM_BUFFER: return &state.uniformBuffer[index];
+			case GL_SHADER_STORAGE_BUFFER: return &state.storageBuffer[index];
+			default: return nullptr;
+			}
+		}
+
+		/**
+		* L/؂ւ@\̋L^擾.
+		*
+		* @param cap @\.
+		*
+		* @return L^ւ̃|C^. L^ΏۊOȂnullptr.
+		*/
+		int* GetCapability(GLenum cap){
+			switch (cap) {
+			case GL_DEPTH_TEST: return &state.depthTest;
+			case GL_CULL_FACE: return &state.cullFace;
+			case GL_BLEND: return &state.blend;
+			case GL_SCISSOR_TEST: return &state.scissorTest;
+			default: return nullptr;
+			}
+		}
+
+	} // unnamed namespace
+
+	/**
+	* pCvCԃIuWFNg쐬.
+	*
+	* @param program `ɎgVF[_. nullptrȂBindŃVF[_ύXȂ.
+	* @param raster  X^CY̏.
+	*
+	* @return 쐬pCvCԃIuWFNgւ̃|C^.
+	*/
+	PipelinePtr Pipeline::Create(const Shader::ProgramPtr& program, const RasterState& raster){
+		struct Impl : Pipeline { Impl() {} ~Impl() {} };
+		std::shared_ptr<Impl> p = std::make_shared<Impl>();
+		p->program = program;
+		p->raster = raster;
+		return p;
+	}
+
+	/**
+	* pCvC̏ԂOpenGLɐݒ肷.
+	*
+	* ݂ƓԂ͐ݒ肵Ȃ.
+	*/
+	void Pipeline::Bind() const{
+		if (program) {
+			program->UseProgram();
+		}
+		Enable(GL_DEPTH_TEST, raster.depthTest);
+		Enable(GL_CULL_FACE, raster.cullFace);
+		Enable(GL_BLEND, raster.blend);
+		if (raster.blend) {
+			BlendFunc(raster.blendSrc, raster.blendDst);
+		}
+	}
+
+	/**
+	* L^ĂԂSĕsɂ.
+	*
+	* ̖OԂ̊֐oRɏԂύXƂA
+	* ܂OpenGLReLXg蒼ƂɌĂяo.
+	*/
+	void Reset(){
+		state.program = unknownId;
+		state.vao = unknownId;
+		state.activeTexture = unknownId;
+		std::fill(std::begin(state.textureTarget), std::end(state.textureTarget), unknownEnum);
+		std::fill(std::begin(state.texture), std::end(state.texture), unknownId);
+		const IndexedBinding unknownBinding = { unknownId, -1, -1 };
+		std::fill(std::begin(state.uniformBuffer), std::end(state.uniformBuffer), unknownBinding);
+		std::fill(std::begin(state.storageBuffer), std::end(state.storageBuffer), unknownBinding);
+		state.framebuffer = unknownId;
+		std::fill(std::begin(state.viewport), std::end(state.viewport), -1);
+		std::fill(std::begin(state.scissor), std::end(state.scissor), -1);
+		state.depthTest = -1;
+		state.cullFace = -1;
+		state.blend = -1;
+		state.scissorTest = -1;
+		state.blendSrc = unknownEnum;
+		state.blendDst = unknownEnum;
+		state.depthMask = -1;
+		state.depthFunc = unknownEnum;
+		state.depthRange[0] = state.depthRange[1] = -1;
+		isInitialized = true;
+	}
+
+	/**
+	* ԕύX̐擾.
+	*
+	* @return ClearStatsĂяoĂ̏ԕύX̐.
+	*/
+	const Stats& GetStats(){
+		return stats;
+	}
+
+	/**
+	* ԕύX̐0ɖ߂.
+	*/
+	void ClearStats(){
+		stats = Stats();
+	}
+
+	/**
+	* `ɎgVF[_ݒ肷.
+	*
+	* @param program vOEIuWFNgID.
+	*/
+	void UseProgram(GLuint program){
+		InitOnce();
+		if (Count(state.program != program)) {
+			glUseProgram(program);
+			state.program = program;
+		}
+	}
+
+	/**
+	* VAOOpenGL̏Ώۂɐݒ肷.
+	*
+	* @param vao VAOID.
+	*/
+	void BindVertexArray(GLuint vao){
+		InitOnce();
+		if (Count(state.vao != vao)) {
+			glBindVertexArray(vao);
+			state.vao = vao;
+		}
+	}
+
+	/**
+	* eNX`eNX`EC[WEjbgɊ蓖Ă.
+	*
+	* @param unit    eNX`EC[WEjbg̔ԍ(GL_TEXTURE0̃ItZbg).
+	* @param target  eNX`̎.
+	* @param texture eNX`ID.
+	*/
+	void BindTexture(GLuint unit, GLenum target, GLuint texture){
+		InitOnce();
+		if (unit < maxTextureUnitCount && state.textureTarget[unit] == target && state.texture[unit] == texture) {
+			Count(false);
+			return;
+		}
+		if (state.activeTexture != unit) {
+			glActiveTexture(GL_TEXTURE0 + unit);
+			state.activeTexture = unit;
+		}
+		glBindTexture(target, texture);
+		Count(true);
+		if (unit < maxTextureUnitCount) {
+			state.textureTarget[unit] = target;
+			state.texture[unit] = texture;
+		}
+	}
+
+	/**
+	* obt@ŜCfbNXtoCfBOE|CgɊ蓖Ă.
+	*
+	* @param target oCfBOE|Cg̎.
+	* @param index  oCfBOE|Cg.
+	* @param buffer obt@EIuWFNgID.
+	*/
+	void BindBufferBase(GLenum target, GLuint index, GLuint buffer){
+		InitOnce();
+		IndexedBinding* p = GetIndexedBinding(target, index);
+		if (p && p->buffer == buffer && p->size == -1) {
+			Count(false);
+			return;
+		}
+		glBindBufferBase(target, index, buffer);
+		Count(true);
+		if (p) {
+			*p = { buffer, 0, -1 };
+		}
+	}
+
+	/**
+	* obt@͈̔͂CfbNXtoCfBOE|CgɊ蓖Ă.
+	*
+	* @param target oCfBOE|Cg̎.
+	* @param index  oCfBOE|Cg.
+	* @param buffer obt@EIuWFNgID.
+	* @param offset 蓖Ă͈͂̐擪̃oCgItZbg.
+	* @param size   蓖Ă͈͂̃oCg.
+	*/
+	void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size){
+		InitOnce();
+		IndexedBinding* p = GetIndexedBinding(target, index);
+		if (p && p->buffer == buffer && p->offset == offset && p->size == size) {
+			Count(false);
+			return;
+		}
+		glBindBufferRange(target, index, buffer, offset, size);
+		Count(true);
+		if (p) {
+			*p = { buffer, offset, size };
+		}
+	}
+
+	/**
+	* t[obt@`ɐݒ肷.
+	*
+	* @param framebuffer t[obt@EIuWFNgID.
+	*/
+	void BindFramebuffer(GLuint framebuffer){
+		InitOnce();
+		if (Count(state.framebuffer != framebuffer)) {
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+			state.framebuffer = framebuffer;
+		}
+	}
+
+	/**
+	* r[|[gݒ肷.
+	*/
+	void Viewport(GLint x, GLint y, GLsizei width, GLsizei height){
+		InitOnce();
+		const GLint v[4] = { x, y, width, height };
+		if (Count(!std::equal(v, v + 4, state.viewport))) {
+			glViewport(x, y, width, height);
+			std::copy(v, v + 4, state.viewport);
+		}
+	}
+
+	/**
+	* VU[`ݒ肷.
+	*/
+	void Scissor(GLint x, GLint y, GLsizei width, GLsizei height){
+		InitOnce();
+		const GLint v[4] = { x, y, width, height };
+		if (Count(!std::equal(v, v + 4, state.scissor))) {
+			glScissor(x, y, width, height);
+			std::copy(v, v + 4, state.scissor);
+		}
+	}
+
+	/**
+	* @\̗L/؂ւ.
+	*
+	* @param cap    @\(GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_SCISSOR_TEST).
+	* @param enable LɂȂtrue, ɂȂfalse.
+	*/
+	void Enable(GLenum cap, bool enable){
+		InitOnce();
+		int* p = GetCapability(cap);
+		if (p && *p == static_cast<int>(enable)) {
+			Count(false);
+			return;
+		}
+		if (enable) {
+			glEnable(cap);
+		} else {
+			glDisable(cap);
+		}
+		Count(true);
+		if (p) {
+			*p = enable;
+		}
+	}
+
+	/**
+	* uȟWݒ肷.
+	*
+	* @param src ͑̌W.
+	* @param dst o͐摤̌W.
+	*/
+	void BlendFunc(GLenum src, GLenum dst){
+		InitOnce();
+		if (Count(state.blendSrc != src || state.blendDst != dst)) {
+			glBlendFunc(src, dst);
+			state.blendSrc = src;
+			state.blendDst = dst;
+		}
+	}
+
+	/**
+	* [xobt@ւ݂̏L/ɂ.
+	*
+	* @param enable ނȂtrue, ܂ȂȂfalse.
+	*/
+	void DepthMask(bool enable){
+		InitOnce();
+		if (Count(state.depthMask != static_cast<int>(enable))) {
+			glDepthMask(enable ? GL_TRUE : GL_FALSE);
+			state.depthMask = enable;
+		}
+	}
+
+	/**
+	* [xeXg̔r֐ݒ肷.
+	*
+	* @param func r֐.
+	*/
+	void DepthFunc(GLenum func){
+		InitOnce();
+		if (Count(state.depthFunc != func)) {
+			glDepthFunc(func);
+			state.depthFunc = func;
+		}
+	}
+
+	/**
+	* KfoCXW̐[x[xobt@̒lɕῗ͈ݒ肷.
+	*
+	* @param zNear O̒l.
+	* @param zFar  ̒l.
+	*/
+	void DepthRange(GLclampd zNear, GLclampd zFar){
+		InitOnce();
+		if (Count(state.depthRange[0] != zNear || state.depthRange[1] != zFar)) {
+			glDepthRange(zNear, zFar);
+			state.depthRange[0] = zNear;
+			state.depthRange[1] = zFar;
+		}
+	}
+
+} // namespace GLState
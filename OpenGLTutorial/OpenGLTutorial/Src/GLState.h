@@ -0,0 +1,83 @@
+/**
+* @file GLState.h
+*/
+#ifndef GLSTATE_H_INCLUDED
+#define GLSTATE_H_INCLUDED
+#include <GL/glew.h>
+#include "Shader.h"
+#include <memory>
+
+/**
+* OpenGL̏ԂL^A݂ƓԂւ̕ύXȗ邽߂̖O.
+*
+* ɂ֐oRɏԂύXꍇ Reset Ăяo.
+*/
+namespace GLState {
+
+	class Pipeline;
+	typedef std::shared_ptr<const Pipeline> PipelinePtr; ///< pCvCԃIuWFNg|C^^.
+
+	/**
+	* ԕύX̐.
+	*/
+	struct Stats {
+		size_t issuedCount = 0; ///< OpenGLɔsԕύX̐.
+		size_t elidedCount = 0; ///< ݂ƓԂ̂ŔsȂԕύX̐.
+	};
+
+	/**
+	* [xeXgAJOAuh̏.
+	*/
+	struct RasterState {
+		bool depthTest; ///< [xeXgsȂtrue.
+		bool cullFace; ///< ʂ`悵ȂȂtrue.
+		bool blend; ///< uhsȂtrue.
+		GLenum blendSrc; ///< uh̓͑̌W.
+		GLenum blendDst; ///< uh̏o͐摤̌W.
+	};
+
+	/**
+	* pCvCԃIuWFNg.
+	*
+	* VF[_ƃX^CY̏Ԃ܂Ƃ߂. 쐬͕ύXłȂ.
+	*/
+	class Pipeline {
+	public:
+		static PipelinePtr Create(const Shader::ProgramPtr& program, const RasterState& raster);
+
+		void Bind() const;
+		const Shader::ProgramPtr& Program() const { return program; }
+		const RasterState& Raster() const { return raster; }
+
+	private:
+		Pipeline() = default;
+		~Pipeline() = default;
+		Pipeline(const Pipeline&) = delete;
+		Pipeline& operator=(const Pipeline&) = delete;
+
+	private:
+		Shader::ProgramPtr program; ///< `ɎgVF[_. nullptrȂVF[_͕ύXȂ.
+		RasterState raster; ///< X^CY̏.
+	};
+
+	void Reset();
+	const Stats& GetStats();
+	void ClearStats();
+
+	void UseProgram(GLuint program);
+	void BindVertexArray(GLuint vao);
+	void BindTexture(GLuint unit, GLenum target, GLuint texture);
+	void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+	void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+	void BindFramebuffer(GLuint framebuffer);
+	void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+	void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+	void Enable(GLenum cap, bool enable);
+	void BlendFunc(GLenum src, GLenum dst);
+	void DepthMask(bool enable);
+	void DepthFunc(GLenum func);
+	void DepthRange(GLclampd zNear, GLclampd zFar);
+
+} // namespace GLState
+
+#endif // GLSTATE_H_INCLUDED
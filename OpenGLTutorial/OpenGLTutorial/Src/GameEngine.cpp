@@ -4,8 +4,13 @@
 #include "GameEngine.h"
 #include "Audio.h"
 #include "GLFWEW.h"
+#include "GLRecorder.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <time.h>
 
 
@@ -83,6 +88,24 @@ static const RenderingData renderingData[] = {
 	MakeRenderingData(6, 12),
 };
 
+/// t[XVUBÕOobt@̃t[(GPU̕`҂ɏ߂t[).
+static const int uboFrameCount = 3;
+
+/**
+* |XgGtFNg̃Xg.
+*
+* SRes/ColorFilter.frag̃}NŎĂāAאڂ̂̓_[Ot1̃VF[_ɂ܂Ƃ߂.
+* order̓VF[_ŌʂKp鏇.
+*/
+static const struct {
+	const char* name; ///< |XgGtFNg.
+	const char* define; ///< ʂLɂ}N.
+	int order; ///< Kp.
+} postEffectList[] = {
+	{ "ColorFilter", "COLOR_MATRIX", 0 },
+	{ "Posterization", "POSTERIZE", 1 },
+};
+
 /**
 * Vertex Buffer Object 쐬.
 *
@@ -148,13 +171,13 @@ void SetVertexAttribPointerI(GLuint index, GLint size, GLsizei stride, const GLv
 GLuint CreateVAO(GLuint vbo, GLuint ibo) {
 	GLuint vao = 0;
 	glGenVertexArrays(1, &vao);
-	glBindVertexArray(vao);
+	GLState::BindVertexArray(vao);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	SetVertexAttribPointer(0, Vertex, position);
 	SetVertexAttribPointer(1, Vertex, color);
 	SetVertexAttribPointer(2, Vertex, texCoord);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-	glBindVertexArray(0);
+	GLState::BindVertexArray(0);
 	return vao;
 }
 
@@ -174,6 +197,10 @@ GameEngine& GameEngine::Instance() {
 * @param w     EBhE̕`͈͂̕(sNZ).
 * @param h     EBhE̕`͈͂̍(sNZ).
 * @param title EBhE^Cg(UTF-80I[).
+* @param contextType OpenGLReLXg̍쐬@.
+*                    ContextType::Headless ̏ꍇ̓EBhE\A
+*                    ʂČł悤ɗ̎Œ肷.
+* @param vertexFormat bV̒_f[^̌`.
 *
 * @retval true  .
 * @retval false s.
@@ -181,60 +208,192 @@ GameEngine& GameEngine::Instance() {
 * Update, Render֐ȂǂĂяoOɁAxĂяoĂKv.
 * xɐƁAȌ̌Ăяoł͂ȂɂtrueԂ.
 */
-bool GameEngine::Init(int w, int h, const char* title){
+bool GameEngine::Init(int w, int h, const char* title, GLFWEW::ContextType contextType, Mesh::VertexFormat vertexFormat){
 	if (isInitialized) {
 		return true;
 	}
-	if (!GLFWEW::Window::Instance().Init(w, h, title)) {
+	if (!GLFWEW::Window::Instance().Init(w, h, title, contextType)) {
 		return false;
 	}
+#ifdef GLRECORDER_ENABLED
+	GLRecorder::Enable();
+#endif
+	// vOEoCiELbV̌ʂmF邽߁AɂԂv.
+	const auto initStartTime = std::chrono::steady_clock::now();
 
 	vbo = CreateVBO(sizeof(vertices), vertices);
 	ibo = CreateIBO(sizeof(indices), indices);
 	vao = CreateVAO(vbo, ibo);
-	uboLight = UniformBuffer::Create(sizeof(Uniform::LightData), 1, "LightingData");
-	uboPostEffect = UniformBuffer::Create(sizeof(Uniform::PostEffectData), 2, "PostEffectData");
+	// t[XVUBÓAGPUÕt[`悵ĂԂ߂悤ɃOobt@ɂ.
+	uboLight = UniformBuffer::Create(sizeof(Uniform::LightData), 1, "LightingData", uboFrameCount);
+	uboPostEffect = UniformBuffer::Create(sizeof(Uniform::PostEffectData), 2, "PostEffectData", uboFrameCount);
+	uboFrame = UniformBuffer::Create(sizeof(Uniform::FrameData), 3, "FrameData", uboFrameCount);
+
+	if (!vbo || !ibo || !vao || !uboLight || !uboPostEffect || !uboFrame) {
+		std::cerr << "ERROR: GameEngine ̏Ɏs" << std::endl;
+		return false;
+	}
 
-	offscreen = OffscreenBuffer::Create(800, 600);
+	// Ԑڕ`pVF[_쐬邩ǂ߂邽߁AVF[_ɃbVobt@쐬.
+	// IBOɂ͏ڍדxCfbNXǉ̂ŁÃCfbNX̔{xmۂĂ.
+	meshBuffer = Mesh::Buffer::Create(10 * 1024, 60 * 1024, vertexFormat);
+	if (!meshBuffer) {
+		std::cerr << "ERROR: GameEngine ̏Ɏs" << std::endl;
+		return false;
+	}
+	const bool isIndirect = meshBuffer->GetIndirectMode() != Mesh::IndirectMode::None;
 
-	if (!vbo || !ibo || !vao || !uboLight || !uboPostEffect || !offscreen) {
+	// CgNX^̃obt@eNX`͑SẴVF[_ŋʂ̃jbgɊ蓖Ă̂ŁAVF[_ɓo^.
+	if (!lightCluster.Init()) {
 		std::cerr << "ERROR: GameEngine ̏Ɏs" << std::endl;
 		return false;
 	}
+	Shader::FixedSamplerUnit("lightGridSampler", LightCluster::gridUnit);
+	Shader::FixedSamplerUnit("lightIndexSampler", LightCluster::indexUnit);
 
 	// VF[_ƃVF[_t@CZbgɂshaderNameListƂzɊi[.
-	static const char* const shaderNameList[][3] = {
-		{ "Tutorial", "Res/Tutorial.vert", "Res/Tutorial.frag" },
-		{ "ColorFilter", "Res/ColorFilter.vert", "Res/ColorFilter.frag" },
-		{ "NonLighting", "Res/NonLighting.vert", "Res/NonLighting.frag" },
+	// 4Ԗڂ̓CX^X`pA5Ԗڂ͊Ԑڕ`p̒_VF[_t@C(Ȃnullptr).
+	// 6Ԗڂ͑SẴVF[_ɒ`}N(Ȃnullptr).
+	// O".NoNormalMap"̃VF[_́Am[}}bv̂ȂGeBeBɎIɎg.
+	// eVF[_ɂ́AeNX`z̑wgGeBeBp".TextureArray"쐬.
+	static const char* const shaderNameList[][6] = {
+		{ "Tutorial", "Res/Tutorial.vert", "Res/Tutorial.frag", "Res/TutorialInstanced.vert", "Res/TutorialIndirect.vert", nullptr },
+		{ "Tutorial.NoNormalMap", "Res/Tutorial.vert", "Res/Tutorial.frag", "Res/TutorialInstanced.vert", "Res/TutorialIndirect.vert", "NO_NORMAL_MAP" },
+		{ "NonLighting", "Res/NonLighting.vert", "Res/Tutorial.frag", "Res/NonLightingInstanced.vert", "Res/NonLightingIndirect.vert", "UNLIT" },
 	};
 	shaderMap.reserve(sizeof(shaderNameList) / sizeof(shaderNameList[0]));
-	// SẴVF[_쐬.
+	const auto shaderStartTime = std::chrono::steady_clock::now();
+	// SẴVF[_̃RpCJnA҂Ԃɑ̏i߂.
+	Shader::ProgramBatch shaderBatch;
 	for (auto& e : shaderNameList) {
-		Shader::ProgramPtr program = Shader::Program::Create(e[1], e[2]);
-		if (!program) {
-			return false;
+		for (bool isTextureArray : { false, true }) {
+			Shader::DefineList defines = e[5] ? Shader::DefineList{ e[5] } : Shader::DefineList();
+			if (isTextureArray) {
+				defines.push_back("TEXTURE_ARRAY");
+			}
+			Shader::ProgramPtr program = shaderBatch.Add(e[1], e[2], defines);
+			if (!program) {
+				return false;
+			}
+			if (e[3]) {
+				Shader::ProgramPtr instanced = shaderBatch.Add(e[3], e[2], defines);
+				if (!instanced) {
+					return false;
+				}
+				program->Instanced(instanced);
+			}
+			if (e[4] && isIndirect) {
+				Shader::ProgramPtr indirect = shaderBatch.Add(e[4], e[2], defines);
+				if (!indirect) {
+					return false;
+				}
+				program->Indirect(indirect);
+			}
+			shaderMap.insert(std::make_pair(std::string(e[0]) + (isTextureArray ? ".TextureArray" : ""), program));
 		}
-		shaderMap.insert(std::make_pair(std::string(e[0]), program));
+	}
+	// wi̓L[u}bvɈx`悵At[͂Sʂɕ`悷.
+	const Shader::ProgramPtr programBackgroundBake = shaderBatch.Add("Res/CubeMapBake.vert", "Res/Tutorial.frag", { "UNLIT" });
+	programBackground = shaderBatch.Add("Res/Background.vert", "Res/Background.frag");
+	if (!programBackgroundBake || !programBackground) {
+		return false;
 	}
 
-	shaderMap["Tutorial"]->UniformBlockBinding("VertexData", 0);
-	shaderMap["Tutorial"]->UniformBlockBinding("LightData", 1);
-	shaderMap["ColorFilter"]->UniformBlockBinding("PostEffectData", 2);
+	entityBuffer = Entity::Buffer::Create(1024, sizeof(Uniform::VertexData), 0, "VertexData", uboFrameCount);
+	if (!entityBuffer) {
+		std::cerr << "ERROR: GameEngine ̏Ɏs" << std::endl;
+		return false;
+	}
+	// //Font::Renderer
+	fontRenderer.Init(1024, glm::vec2(800, 600), &shaderBatch);
 
-	meshBuffer = Mesh::Buffer::Create(10 * 1024, 30 * 1024);
-	if (!meshBuffer) {
+	// ̓VF[_̃NʂKv.
+	if (!shaderBatch.Finish()) {
 		std::cerr << "ERROR: GameEngine ̏Ɏs" << std::endl;
 		return false;
 	}
-	entityBuffer = Entity::Buffer::Create(1024, sizeof(Uniform::VertexData), 0, "VertexData");
-	if (!entityBuffer) {
+	const std::chrono::duration<double, std::milli> shaderTime = std::chrono::steady_clock::now() - shaderStartTime;
+
+	// }NɂĎgȂubN̂ŁAeVF[_ĂubN蓖Ă.
+	// Ԑڕ`pVF[_̓GeBeBƂ̃f[^SSBOǂݍ.
+	static const struct {
+		GLenum type;
+		const char* name;
+		GLuint bindingPoint;
+	} blockBindingList[] = {
+		{ GL_UNIFORM_BLOCK, "VertexData", 0 },
+		{ GL_UNIFORM_BLOCK, "LightData", 1 },
+		{ GL_UNIFORM_BLOCK, "PostEffectData", 2 },
+		{ GL_UNIFORM_BLOCK, "FrameData", 3 },
+		{ GL_SHADER_STORAGE_BLOCK, "VertexData", Entity::payloadStorageBindingPoint },
+		{ GL_SHADER_STORAGE_BLOCK, "DrawData", Entity::drawDataStorageBindingPoint },
+	};
+	for (auto& e : shaderMap) {
+		for (const Shader::ProgramPtr& program : { e.second, e.second->Instanced(), e.second->Indirect() }) {
+			if (!program) {
+				continue;
+			}
+			for (auto& block : blockBindingList) {
+				if (!program->FindBlock(block.type, block.name)) {
+					continue;
+				}
+				if (block.type == GL_UNIFORM_BLOCK) {
+					program->UniformBlockBinding(block.name, block.bindingPoint);
+				} else {
+					program->ShaderStorageBlockBinding(block.name, block.bindingPoint);
+				}
+			}
+		}
+	}
+
+	// CeBOsȂVF[_́A@̉]⎲Ƃ̑傫KvƂȂ.
+	entityBuffer->Payload<Uniform::CompactVertexData>(shaderMap["NonLighting"]);
+	entityBuffer->Payload<Uniform::CompactVertexData>(shaderMap["NonLighting.TextureArray"]);
+	if (isIndirect && !entityBuffer->Indirect(true)) {
 		std::cerr << "ERROR: GameEngine ̏Ɏs" << std::endl;
 		return false;
 	}
-	rand.seed(std::random_device()());
-	// //Font::Renderer
-	fontRenderer.Init(1024, glm::vec2(800, 600));
+	// 3DV[̃VF[_̓GeBeBƂɐ؂ւ̂ŁApCvCɂ͊܂߂Ȃ.
+	// uh͔̃GeBeB`悷Ƃ Entity::Buffer::Draw Lɂ.
+	pipelineScene = GLState::Pipeline::Create(nullptr, { true, true, false, GL_ONE, GL_ZERO });
+	// |XgGtFNg̃VF[_̓_[Ot܂Ƃߕɉč쐬̂ŁApCvCɂ͊܂߂Ȃ.
+	pipelinePostEffect = GLState::Pipeline::Create(nullptr, { false, false, false, GL_ONE, GL_ZERO });
+	// wĩbV͓猩̂ŁAJOȂ.
+	pipelineBackgroundBake = GLState::Pipeline::Create(programBackgroundBake, { true, false, false, GL_ONE, GL_ZERO });
+	// 3DV[̕`͍ő𑜓xŊmۂA𑜓xƂ͂̈ꕔɕ`悷.
+	gpuProfiler.Init();
+	resolutionScaler.Init(800, 600);
+	renderGraph = RenderGraph::Graph::Create(800, 600,
+		[](const Shader::DefineList& defines) {
+			Shader::ProgramPtr program = Shader::Program::Create("Res/ColorFilter.vert", "Res/ColorFilter.frag", defines);
+			if (program && program->FindBlock(GL_UNIFORM_BLOCK, "PostEffectData")) {
+				program->UniformBlockBinding("PostEffectData", 2);
+			}
+			return program;
+		},
+		[this](const Shader::ProgramPtr& program, GLuint texture, const glm::vec2& texCoordScale) {
+			pipelinePostEffect->Bind();
+			program->UseProgram();
+			glUniform2f(program->UniformLocation("texCoordScale"), texCoordScale.x, texCoordScale.y);
+			program->BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, texture);
+			GLState::BindVertexArray(vao);
+			glDrawElements(GL_TRIANGLES, renderingData[1].size, GL_UNSIGNED_INT, renderingData[1].offset);
+		}
+	);
+	if (!PostEffect({ "ColorFilter" })) {
+		std::cerr << "ERROR: GameEngine ̏Ɏs" << std::endl;
+		return false;
+	}
+	if (contextType == GLFWEW::ContextType::Headless) {
+		rand.seed(0);
+	} else {
+		rand.seed(std::random_device()());
+	}
+
+	const std::chrono::duration<double, std::milli> initTime = std::chrono::steady_clock::now() - initStartTime;
+	const Shader::ProgramCacheStats& cacheStats = Shader::GetProgramCacheStats();
+	std::cout << "GameEngine::Init: " << initTime.count() << "ms (VF[_: " << shaderTime.count() <<
+		"ms, vOLbV: " << cacheStats.hitCount << "ǂݍ/" << cacheStats.missCount << "RpC)" << std::endl;
 
 	isInitialized = true;
 	return true;
@@ -245,22 +404,107 @@ bool GameEngine::Init(int w, int h, const char* title){
 * @tips	JƎsŏxقȂꍇA
 *		Q[̓쑬xӐ}̂Ƃ͈قȂ\B
 *		̂߁Aۂ̌oߎԂvB
+*
+* @param frameCount st[. 0ȂEBhE܂Ŏs.
+*
+* frameCountw肵ꍇAIɃt[Ԃ̓vƍŌ̃t[̉摜̃nbVlo͂.
+* wbhX̏ꍇ́As邽тɓʂɂȂ悤ɌoߎԂ1/60bɌŒ肵A
+* t[ԂGPȔԂ܂܂悤ɁAt[ƂGPŮ҂.
 */
-void GameEngine::Run(){
+void GameEngine::Run(int frameCount){
 	GLFWEW::Window& window = GLFWEW::Window::Instance();
+	const bool isHeadless = window.IsHeadless();
+	std::vector<double> frameTimeList;
+	frameTimeList.reserve(frameCount);
+	GLRecorder::Stats totalCallStats;
 
 	// ݂̎(b)擾(u[N|CgȂǂ̈ꎞ~i)
-	double prevTime = glfwGetTime();
+	double prevTime = window.Time();
 
-	while (!window.ShouldClose()) {
-		const double curTime = glfwGetTime();
-		const double delta = curTime - prevTime;
+	for (int frame = 0; !window.ShouldClose() && (frameCount <= 0 || frame < frameCount); ++frame) {
+		const double curTime = window.Time();
+		const double delta = isHeadless ? 1.0 / 60.0 : curTime - prevTime;
 		prevTime = curTime;
 		window.UpdateGamePad();
+		// obt@ւ݂̏UpdatełŝŁAL^t[ɂUpdateRender̗܂߂.
+		GLRecorder::BeginFrame();
 		Update(glm::min(0.25, delta));//fobOp0.25zȂ悤ɐ
 		Render();
+		GLRecorder::EndFrame();
+		if (GLRecorder::IsEnabled()) {
+			const GLRecorder::Stats& stats = GLRecorder::FrameStats();
+			for (int i = 0; i < GLRecorder::Category_Count; ++i) {
+				totalCallStats.callCount[i] += stats.callCount[i];
+			}
+			totalCallStats.totalCallCount += stats.totalCallCount;
+			totalCallStats.drawIndexCount += stats.drawIndexCount;
+			totalCallStats.uploadBytes += stats.uploadBytes;
+			totalCallStats.persistentWriteBytes += stats.persistentWriteBytes;
+		}
+		if (isHeadless) {
+			glFinish();
+		}
+		if (frameCount > 0) {
+			frameTimeList.push_back((window.Time() - curTime) * 1000.0);
+			if (frame == frameCount - 1) {
+				frameHash = CalcFrameHash(); // obt@؂ւƃobNobt@̓e͕sɂȂ.
+			}
+		}
 		window.SwapBuffers();
 	}
+
+	if (frameTimeList.empty()) {
+		return;
+	}
+	double totalTime = 0;
+	for (double t : frameTimeList) {
+		totalTime += t;
+	}
+	std::vector<double> sorted = frameTimeList;
+	std::sort(sorted.begin(), sorted.end());
+	const auto percentile = [&sorted](double p) {
+		return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())))];
+	};
+	const GpuProfiler::Result& gpu = gpuProfiler.FrameResult();
+	std::cout << "GameEngine::Run: " << frameTimeList.size() << "t[, " << totalTime << "ms (: " <<
+		totalTime / static_cast<double>(frameTimeList.size()) << "ms, ŏ: " << sorted.front() <<
+		"ms, l: " << percentile(0.5) << "ms, 95%: " << percentile(0.95) << "ms, 99%: " << percentile(0.99) <<
+		"ms, ő: " << sorted.back() << "ms, GPU: " << gpu.avgTime << "ms)" << std::endl;
+	std::cout << "GameEngine::Run: Ō̃t[̃nbVl: " << std::hex << std::setw(16) << std::setfill('0') <<
+		frameHash << std::dec << std::setfill(' ') << std::endl;
+	if (GLRecorder::IsEnabled()) {
+		const double n = static_cast<double>(frameTimeList.size());
+		std::cout << "GameEngine::Run: 1t[OpenGLĂяo: " << totalCallStats.totalCallCount / n << " (";
+		for (int i = 0; i < GLRecorder::Category_Count; ++i) {
+			std::cout << (i ? ", " : "") << GLRecorder::CategoryName(static_cast<GLRecorder::Category>(i)) << ": " <<
+				totalCallStats.callCount[i] / n;
+		}
+		std::cout << "), CfbNX: " << totalCallStats.drawIndexCount / n << ", ]: " <<
+			totalCallStats.uploadBytes / n << "oCg, i}bvւ̏: " <<
+			totalCallStats.persistentWriteBytes / n << "oCg" << std::endl;
+	}
+}
+
+/**
+* ftHgt[obt@̉摜̃nbVlvZ.
+*
+* @return obNobt@RGBA8̉fFNV-1aŌvZnbVl.
+*
+* `挋ʂςĂȂA摜ۑɔr邽߂Ɏg.
+*/
+uint64_t GameEngine::CalcFrameHash() const{
+	GLint viewport[4];
+	GLState::BindFramebuffer(0);
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	std::vector<uint8_t> pixels(viewport[2] * viewport[3] * 4);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadBuffer(GL_BACK);
+	glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	uint64_t hash = 14695981039346656037ULL;
+	for (uint8_t e : pixels) {
+		hash = (hash ^ e) * 1099511628211ULL;
+	}
+	return hash;
 }
 
 /**
@@ -284,17 +528,21 @@ const GameEngine::UpdateFuncType& GameEngine::UpdateFunc() const{
 /**
 * eNX`ǂݍ.
 *
-* @param filename eNX`t@C.
+* @param filename       eNX`t@C.
+* @param isTextureArray trueȂeNX`z̑wƂēǂݍ.
+*                       傫ƃf[^`eNX`͓eNX`zɊi[̂ŁA
+*                       eNX`قȂGeBeB1̕`施߂ŕ`ł.
+*                       GeBeBȊO(tHgAwiȂ)̕`ɎgeNX`ɂ͎w肵Ȃ.
 *
 * @retval true  ǂݍݐ.
 * @retval false ǂݍݎs.
 */
-bool GameEngine::LoadTextureFromFile(const char* filename){
+bool GameEngine::LoadTextureFromFile(const char* filename, bool isTextureArray){
 	const auto itr = textureBuffer.find(filename);
 	if (itr != textureBuffer.end()) {
 		return true;
 	}
-	TexturePtr texture = Texture::LoadFromFile(filename);
+	TexturePtr texture = Texture::LoadFromFile(filename, isTextureArray ? &textureArrayList : nullptr);
 	if (!texture) {
 		return false;
 	}
@@ -362,11 +610,115 @@ Entity::Entity* GameEngine::AddEntity(int groupId, const glm::vec3& pos,
 	if (normalName) {//0ɂƁuDummyv
 		tex[1] = GetTexture(normalName);
 	} else {
+		// m[}}bvgȂVF[_΁Aɐ؂ւă_~[eNX`̓ǂݎȂ.
+		// _~[eNX`͕`揇̕בւ̂߂ɐݒ肷邪ATv[Ȃ̂Ŋ蓖ĂȂ.
+		const auto itrNoNormalMap = shaderMap.find(itr->first + ".NoNormalMap");
+		if (itrNoNormalMap != shaderMap.end()) {
+			itr = itrNoNormalMap;
+		}
 		tex[1] = GetTexture("Res/Dummy.Normal.bmp");
 	}
+	// eNX`z̑ẃAw̔ԍ󂯎VF[_ŕ`悷.
+	// m[}}bvgȂAm[}}bvނ̃eNX`łȂ΂ȂȂ.
+	if (tex[0] && tex[0]->Array()) {
+		if (normalName && tex[1] && !tex[1]->Array()) {
+			std::cerr << "WARNING: '" << texName << "'̓eNX`z̑włA'" << normalName <<
+				"'̓eNX`z̑wł͂܂" << std::endl;
+			return nullptr;
+		}
+		const auto itrTextureArray = shaderMap.find(itr->first + ".TextureArray");
+		if (itrTextureArray == shaderMap.end()) {
+			return nullptr;
+		}
+		itr = itrTextureArray;
+	} else if (normalName && tex[1] && tex[1]->Array()) {
+		std::cerr << "WARNING: '" << normalName << "'̓eNX`z̑włA'" << texName <<
+			"'̓eNX`z̑wł͂܂" << std::endl;
+		return nullptr;
+	}
 	return entityBuffer->AddEntity(groupId, pos, mesh, tex, itr->second, func);
 }
 
+/**
+* |XgGtFNgݒ肵A_[Ot蒼.
+*
+* @param effectList Kp|XgGtFNg("ColorFilter", "Posterization")̃Xg.
+*                   Ȃ3DV[̂܂ܕ\.
+*
+* @retval true  ݒ萬.
+* @retval false |XgGtFNgȂA܂̓_[Ot̍쐬Ɏs.
+*               ȂꍇA_[Ot͕ύXȂ.
+*
+* אڂ|XgGtFNg1̃VF[_ɂ܂Ƃ߂̂ŁA
+* ʂ𑝂₵ĂԂ̃ItXN[obt@ƑSʂ̓ǂݍ݂͑Ȃ.
+*/
+bool GameEngine::PostEffect(const std::vector<std::string>& effectList){
+	// OSĊmFĂ蒼. ȂO΁Ã_[Ot̂܂܎g.
+	std::vector<decltype(std::begin(postEffectList))> effects;
+	effects.reserve(effectList.size());
+	for (const std::string& name : effectList) {
+		const auto itr = std::find_if(std::begin(postEffectList), std::end(postEffectList), [&name](decltype(postEffectList[0]) e) {
+			return name == e.name;
+		});
+		if (itr == std::end(postEffectList)) {
+			std::cerr << "WARNING: '" << name << "'̓|XgGtFNgł͂܂" << std::endl;
+			return false;
+		}
+		effects.push_back(itr);
+	}
+
+	renderGraph->Clear();
+	const RenderGraph::ResourceId scene = renderGraph->CreateTarget("Scene", resolutionScaler.MaxWidth(), resolutionScaler.MaxHeight());
+	sceneTarget = scene;
+	renderGraph->AddPass("Scene", {}, scene, [this](const RenderGraph::Graph&) {
+		pipelineScene->Bind();
+		glClearColor(0.1f, 0.3f, 0.5f, 1.0f);
+		glClearDepth(1);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		lightCluster.Bind();
+		entityBuffer->Draw(meshBuffer);
+	});
+
+	RenderGraph::ResourceId input = scene;
+	for (size_t i = 0; i < effects.size(); ++i) {
+		const auto itr = effects[i];
+		const RenderGraph::ResourceId output = i + 1 < effects.size() ?
+			renderGraph->CreateTarget(itr->name, 800, 600) : RenderGraph::backbuffer;
+		renderGraph->AddEffectPass(itr->name, input, output, itr->define, itr->order);
+		input = output;
+	}
+	if (effects.empty()) {
+		renderGraph->AddEffectPass("Copy", scene, RenderGraph::backbuffer, nullptr, 0);
+	}
+
+	// ̓|XgGtFNǧʂɏd˂ĕ`悷.
+	renderGraph->AddPass("Font", { RenderGraph::backbuffer }, RenderGraph::backbuffer, [this](const RenderGraph::Graph&) {
+		fontRenderer.Draw();
+	});
+	return renderGraph->Compile();
+}
+
+/**
+* 3DV[̉𑜓xGPU̕`掞Ԃɍ킹ĕς邩ǂݒ肷.
+*
+* @param enable          ςȂtrue, ςȂȂfalse.
+* @param targetFrameTime ڕWƂGPU̕`掞(~b).
+*
+* @retval true  ݒ萬.
+* @retval false GPU̕`掞ԂvłȂ̂ŗLɂłȂ.
+*
+* LɂƁA`掞ԂڕW𒴂t[̐t[ɉ𑜓xA
+* ]T̂ԂΏ̉𑜓xɖ߂.
+*/
+bool GameEngine::DynamicResolution(bool enable, double targetFrameTime){
+	if (enable && !gpuProfiler.IsEnabled()) {
+		std::cerr << "WARNING: GPU̕`掞ԂvłȂ߁A𑜓x͕ύX܂" << std::endl;
+		return false;
+	}
+	resolutionScaler.Enable(enable, targetFrameTime);
+	return true;
+}
+
 /**
 *@GeBeB폜.
 *
@@ -379,15 +731,38 @@ void GameEngine::RemoveEntity(Entity::Entity* e){
 /**
 * Cgݒ肷.
 *
-* @param indes  ݒ肷郉Cg̃CfbNX.
-* @param light  Cgp[^.
+* @param indes  ݒ肷郉Cg̃CfbNX(0`Uniform::fixedLightCount-1).
+* @param light  Cgp[^. position.w͖A邳狁߂e͈͂ݒ肳.
 */
 void GameEngine::Light(int index, const Uniform::PointLight& light){
-	if (index < 0 || index >= Uniform::maxLightCount) {
+	if (index < 0 || index >= Uniform::fixedLightCount) {
 		std::cerr << "WARNING: '" << index << "'͕sȃCgCfbNXł" << std::endl;
 		return;
 	}
 	lightData.light[index] = light;
+	lightData.light[index].position.w = LightCluster::Range(light.color);
+}
+
+/**
+* ̃t[LȃCgǉ.
+*
+* @param position Cg̍W([hWn).
+* @param color    Cg̖邳.
+*
+* @retval true  ǉ.
+* @retval false Cg̐ɒBĂ̂ŒǉȂ.
+*
+* ǉCg͎̃t[̍XVn߂Ƃɍ폜.
+* ԍXV֐GeBeB̍XV֐At[Ăяo.
+*/
+bool GameEngine::AddLight(const glm::vec3& position, const glm::vec3& color){
+	if (lightCount >= Uniform::maxLightCount) {
+		return false;
+	}
+	Uniform::PointLight& light = lightData.light[lightCount++];
+	light.color = glm::vec4(color, 1);
+	light.position = glm::vec4(position, LightCluster::Range(light.color));
+	return true;
 }
 
 /**
@@ -398,7 +773,7 @@ void GameEngine::Light(int index, const Uniform::PointLight& light){
 * @return Cgp[^.
 */
 const Uniform::PointLight& GameEngine::Light(int index) const{
-	if (index < 0 || index >= Uniform::maxLightCount) {
+	if (index < 0 || index >= Uniform::fixedLightCount) {
 		std::cerr << "WARNING: '" << index << "'͕sȃCgCfbNXł" << std::endl;
 		static const Uniform::PointLight dummy;
 		return dummy;
@@ -424,6 +799,93 @@ const glm::vec4& GameEngine::AmbientLight() const{
 	return lightData.ambientColor;
 }
 
+/**
+* wĩbVL[u}bvɕ`悵AȌ̓GeBeB̑ɃL[u}bvŔwi`悷.
+*
+* @param meshName wĩbV. _͂ދȂǂ́A猩郁bVł邱.
+* @param texName  wĩbVɎgeNX`t@C.
+* @param size     L[u}bv1ʂ̕ƍ(sNZ).
+*
+* @retval true  `搬.
+* @retval false bV܂̓eNX`ȂA܂̓L[u}bv̍쐬Ɏs.
+*
+* L[u}bv̓bV̒S猩wiɂȂAt[̕`
+* s̃GeBeB̌ɍő[x1񂾂s. ] BackgroundRotation Őݒ肷.
+* bVeNX`ύXƂ́AxĂяoĕ`悵.
+*/
+bool GameEngine::BakeBackground(const char* meshName, const char* texName, int size){
+	const Mesh::MeshPtr& mesh = meshBuffer->GetMesh(meshName);
+	const TexturePtr& texture = GetTexture(texName);
+	if (!mesh || !texture) {
+		std::cerr << "WARNING: wĩbV'" << meshName << "'܂̓eNX`'" << texName << "'܂" << std::endl;
+		return false;
+	}
+	if (!backgroundCubeMap || backgroundCubeMap->Size() != size) {
+		backgroundCubeMap = CubeMapBuffer::Create(size);
+		if (!backgroundCubeMap) {
+			return false;
+		}
+	}
+
+	// L[u}bv̊eʂ̎Ə(GL_TEXTURE_CUBE_MAP_POSITIVE_X ̏).
+	static const glm::vec3 faceList[6][2] = {
+		{ glm::vec3(1, 0, 0), glm::vec3(0, -1, 0) },
+		{ glm::vec3(-1, 0, 0), glm::vec3(0, -1, 0) },
+		{ glm::vec3(0, 1, 0), glm::vec3(0, 0, 1) },
+		{ glm::vec3(0, -1, 0), glm::vec3(0, 0, -1) },
+		{ glm::vec3(0, 0, 1), glm::vec3(0, -1, 0) },
+		{ glm::vec3(0, 0, -1), glm::vec3(0, -1, 0) },
+	};
+	const Mesh::Bounds& bounds = mesh->GetBounds();
+	const float radius = std::max(bounds.radius, 1.0f);
+	const glm::mat4 matProj = glm::perspective(glm::radians(90.0f), 1.0f, radius * 0.01f, radius * 2.0f);
+	const Shader::ProgramPtr& program = pipelineBackgroundBake->Program();
+	pipelineBackgroundBake->Bind();
+	GLState::DepthMask(true);
+	GLState::DepthFunc(GL_LESS);
+	GLState::DepthRange(0, 1);
+	program->BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, texture->Id());
+	meshBuffer->BindVAO();
+	const GLint locMatVP = program->UniformLocation("matVP");
+	for (int face = 0; face < 6; ++face) {
+		backgroundCubeMap->BindFace(face);
+		glClearColor(0, 0, 0, 1);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		const glm::mat4 matView = glm::lookAt(bounds.center, bounds.center + faceList[face][0], faceList[face][1]);
+		const glm::mat4 matVP = matProj * matView;
+		glUniformMatrix4fv(locMatVP, 1, GL_FALSE, &matVP[0][0]);
+		mesh->Draw(meshBuffer);
+	}
+	GLState::BindFramebuffer(0);
+
+	entityBuffer->BackgroundFunc([this]() { DrawBackground(); });
+	return true;
+}
+
+/**
+* L[u}bvɂwi̕`߂.
+*/
+void GameEngine::ClearBackground(){
+	entityBuffer->BackgroundFunc(nullptr);
+	backgroundCubeMap.reset();
+}
+
+/**
+* L[u}bv̔wiSʂɕ`悷.
+*
+* Entity::Buffer::Draw wiL[̏(ő[xA[x݂Ȃ)ŌĂяo.
+* _̈ړ͖Ar[s̉]Ɣwỉ]ŃL[u}bv̕߂.
+*/
+void GameEngine::DrawBackground() const{
+	const glm::mat4 matViewRotation(glm::mat3(frameData.matView));
+	const glm::mat4 matClipToCube = glm::inverse(frameData.matProj * matViewRotation * glm::mat4_cast(backgroundRotation));
+	programBackground->UseProgram();
+	glUniformMatrix4fv(programBackground->UniformLocation("matClipToCube"), 1, GL_FALSE, &matClipToCube[0][0]);
+	programBackground->BindTexture(GL_TEXTURE0, GL_TEXTURE_CUBE_MAP, backgroundCubeMap->GetTexture());
+	GLState::BindVertexArray(vao);
+	glDrawElements(GL_TRIANGLES, renderingData[1].size, GL_UNSIGNED_INT, renderingData[1].offset);
+}
+
 /**
 * _̈ʒuƎpݒ肷.
 *
@@ -546,14 +1008,22 @@ void GameEngine::Update(double delta){
 
 	// pVBO(XV֐AddString֐Ăяo悤ɂ).
 	fontRenderer.MapBuffer();
+	// Õt[ɒǉCg폜.
+	lightCount = Uniform::fixedLightCount;
 
 	if (updateFunc) {
 		updateFunc(delta);
 	}
 
-	const glm::mat4x4 matProj = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 1.0f, 200.0f);
-	const glm::mat4x4 matView = glm::lookAt(camera.position, camera.target, camera.up);
-	entityBuffer->Update(delta, matView, matProj);
+	// JƃvWFNV̓t[ƂUBOœ]̂ŁAGeBeBƂ̃f[^͍XVȂĂ悢.
+	frameData.matProj = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 1.0f, 200.0f);
+	frameData.matView = glm::lookAt(camera.position, camera.target, camera.up);
+	frameData.matVP = frameData.matProj * frameData.matView;
+	frameData.time += static_cast<float>(delta);
+	frameData.deltaTime = static_cast<float>(delta);
+	entityBuffer->Update(delta, frameData.matView, frameData.matProj, Entity::MakeFrustum(frameData.matVP));
+	// GeBeB̍XV֐ǉCg܂߂āACgNX^ɐU蕪.
+	lightCluster.Build(lightData.light, lightCount, frameData.matView, frameData.matProj);
 	// VBOGPUɓ].
 	fontRenderer.UnmapBuffer();
 }
@@ -562,33 +1032,32 @@ void GameEngine::Update(double delta){
 * Q[̏Ԃ`悷.
 */
 void GameEngine::Render() const{
+	GLState::ClearStats();
 
-	glBindFramebuffer(GL_FRAMEBUFFER, offscreen->GetFramebuffer());
-	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_CULL_FACE);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glViewport(0, 0, 800, 600);
-	glScissor(0, 0, 800, 600);
-	glClearColor(0.1f, 0.3f, 0.5f, 1.0f);
-	glClearDepth(1);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	uboLight->BufferSubData(&lightData);
-	entityBuffer->Draw(meshBuffer);
-
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glDisable(GL_DEPTH_TEST);
-	glDisable(GL_CULL_FACE);
-	glDisable(GL_BLEND);
-	glBindVertexArray(vao);
-	const Shader::ProgramPtr& progColorFilter = shaderMap.find("ColorFilter")->second;
-	progColorFilter->UseProgram();
+	uboFrame->BufferSubData(&frameData);
 	Uniform::PostEffectData postEffect;
 	uboPostEffect->BufferSubData(&postEffect);
-	progColorFilter->BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, offscreen->GetTexutre());
-	glDrawElements(GL_TRIANGLES, renderingData[1].size, GL_UNSIGNED_INT, renderingData[1].offset);
-	// `悷.
-	fontRenderer.Draw();
+	// 3DV[A|XgGtFNgȀɕ`悷.
+	// 3DV[͉𑜓xĂΕ`̈ꕔɕ`悵A|XgGtFNgŉʑŜɊg傷.
+	// 𑜓x͐t[OɌvGPU̕`掞ԂŌ߂.
+	if (gpuProfiler.BeginFrame()) {
+		resolutionScaler.Update(gpuProfiler.FrameResult().lastTime);
+	}
+	// Cg͎gĂ镪]. NX^̃p[^͕`͈͂̑傫܂Ă.
+	uboLight->BufferSubData(&lightData, 0, offsetof(Uniform::LightData, light) + sizeof(Uniform::PointLight) * lightCount);
+	const Uniform::ClusterData clusterData = lightCluster.Data(resolutionScaler.Width(), resolutionScaler.Height());
+	uboLight->BufferSubData(&clusterData, offsetof(Uniform::LightData, cluster), sizeof(clusterData));
+	renderGraph->Viewport(sceneTarget, resolutionScaler.Width(), resolutionScaler.Height());
+	renderGraph->Execute(&gpuProfiler);
+	gpuProfiler.EndFrame();
+
+	// ̃t[̕`施߂SĔŝŁAUBÕt[̗̈ɐ؂ւ.
+	uboLight->NextFrame();
+	uboPostEffect->NextFrame();
+	uboFrame->NextFrame();
+	entityBuffer->NextFrame();
+
+	glStateStats = GLState::GetStats();
 }
 
 /**
@@ -15,6 +15,13 @@
 #include "Uniform.h"
 #include "GamePad.h"
 #include "Font.h"
+#include "GLState.h"
+#include "RenderGraph.h"
+#include "ResolutionScaler.h"
+#include "GpuProfiler.h"
+#include "LightCluster.h"
+#include "CubeMapBuffer.h"
+#include "GLFWEW.h"
 #include <glm/glm.hpp>
 #include <functional>
 #include <random>
@@ -34,13 +41,17 @@ public:
 	};
 
 	static GameEngine& Instance();
-	bool Init(int w, int h, const char* title);
-	void Run();
+	bool Init(int w, int h, const char* title, GLFWEW::ContextType contextType = GLFWEW::ContextType::Window,
+		Mesh::VertexFormat vertexFormat = Mesh::VertexFormat::Packed);
+	void Run(int frameCount = 0);
+	/// O Run(frameCount) ōŌɕ`悵t[̉摜̃nbVl擾.
+	uint64_t FrameHash() const { return frameHash; }
+	uint64_t CalcFrameHash() const;
 	void UpdateFunc(const UpdateFuncType& func);
 	const UpdateFuncType& UpdateFunc() const;
 
 	bool LoadMeshFromFile(const char* filename);
-	bool LoadTextureFromFile(const char* filename);
+	bool LoadTextureFromFile(const char* filename, bool isTextureArray = false);
 	Entity::Entity* AddEntity(int groupId, const glm::vec3& pos, const char* meshName,
 		const char* texName, Entity::Entity::UpdateFuncType func, const char* shader = nullptr
 	);
@@ -52,8 +63,15 @@ public:
 	void RemoveEntity(Entity::Entity*);
 	void Light(int index, const Uniform::PointLight& light);
 	const Uniform::PointLight& Light(int index) const;
+	bool AddLight(const glm::vec3& position, const glm::vec3& color);
 	void AmbientLight(const glm::vec4& color);
 	const glm::vec4& AmbientLight() const;
+	bool BakeBackground(const char* meshName, const char* texName, int size = 1024);
+	void ClearBackground();
+	/// wĩL[u}bv̉]ݒ肷.
+	void BackgroundRotation(const glm::quat& rotation) { backgroundRotation = rotation; }
+	/// wĩL[u}bv̉]擾.
+	const glm::quat& BackgroundRotation() const { return backgroundRotation; }
 	void Camera(const CameraData& cam);
 	const CameraData& Camera() const;
 	std::mt19937& Rand();
@@ -66,6 +84,11 @@ public:
 	void CollisionHandler(int gid0, int gid1, Entity::CollisionHandlerType handler);
 	const Entity::CollisionHandlerType& CollisionHandler(int gid0, int gid1) const;
 	void ClearCollisionHandlerList();
+	/// Õt[ŃGeBeB̕`ɔsԕύX̐擾.
+	const Entity::DrawStats& EntityDrawStats() const { return entityBuffer->GetDrawStats(); }
+	const Entity::UpdateProfile& EntityProfile() const { return entityBuffer->Profile(); }
+	/// Õt[Ŕs܂͏ȗOpenGL̏ԕύX̐擾.
+	const GLState::Stats& GLStateStats() const { return glStateStats; }
 
 	const TexturePtr& GetTexture(const char* filename) const {
 		static const TexturePtr dummy;
@@ -80,6 +103,22 @@ public:
 	}
 	void FontScale(const glm::vec2& scale) { fontRenderer.Scale(scale); }
 	void FontColor(const glm::vec4& color) { fontRenderer.Color(color); }
+	bool PostEffect(const std::vector<std::string>& effectList);
+	/// Oɍ蒼_[Ot̃pXƃItXN[obt@̐擾.
+	const RenderGraph::Stats& RenderGraphStats() const { return renderGraph->GetStats(); }
+	bool DynamicResolution(bool enable, double targetFrameTime = 1000.0 / 60.0);
+	/// 3DV[݂̌̉𑜓x̊g嗦擾.
+	float ResolutionScale() const { return resolutionScaler.Scale(); }
+	/// ߂Ɍvłt[ŜGPU̕`掞(~b)擾.
+	double GpuFrameTime() const { return gpuProfiler.FrameResult().lastTime; }
+	/// t[ŜGPU̕`掞Ԃ̓v擾.
+	const GpuProfiler::Result& GpuFrameProfile() const { return gpuProfiler.FrameResult(); }
+	/// `pXƂGPU̕`掞Ԃ̓v擾.
+	const std::vector<GpuProfiler::Result>& GpuProfile() const { return gpuProfiler.Results(); }
+	/// `pXƂ̃pCvCvv邩ǂݒ肷.
+	bool PipelineStatistics(bool enable) { return gpuProfiler.PipelineStatistics(enable); }
+	/// Õt[ŃCgNX^ɐU蕪ʂ擾.
+	const LightCluster::Stats& LightClusterStats() const { return lightCluster.GetStats(); }
 	double& UserVariable(const char* name) { return userNumbers[name]; }
 	
 private:
@@ -89,10 +128,12 @@ private:
 	GameEngine& operator=(const GameEngine&) = delete;
 	void Update(double delta);
 	void Render() const;
+	void DrawBackground() const;
 
 private:
 	bool isInitialized = false;
 	UpdateFuncType updateFunc;
+	uint64_t frameHash = 0; ///< Run(frameCount) ōŌɕ`悵t[̉摜̃nbVl.
 
 	//<--- Ƀo֐ǉ --->
 	GLuint vbo = 0;
@@ -101,13 +142,28 @@ private:
 	UniformBufferPtr uboLight;
 	UniformBufferPtr uboPostEffect;
 	std::unordered_map<std::string, Shader::ProgramPtr> shaderMap;
-	OffscreenBufferPtr offscreen;
+	RenderGraph::GraphPtr renderGraph;       ///< 3DV[ƃ|XgGtFNg̕`pX.
+	RenderGraph::ResourceId sceneTarget = RenderGraph::backbuffer; ///< 3DV[̕`.
+	mutable ResolutionScaler resolutionScaler; ///< 3DV[̉𑜓x̐.
+	mutable GpuProfiler gpuProfiler;         ///< `pXƂGPU̕`掞Ԃ̌v.
+	GLState::PipelinePtr pipelineScene;      ///< 3DV[`ppCvC.
+	GLState::PipelinePtr pipelinePostEffect; ///< |XgGtFNgppCvC(VF[_).
+	GLState::PipelinePtr pipelineBackgroundBake; ///< wiL[u}bvɕ`悷pCvC.
+	Shader::ProgramPtr programBackground;    ///< L[u}bv̔wiSʂɕ`悷VF[_.
+	CubeMapBufferPtr backgroundCubeMap;      ///< wi`悵L[u}bv.
+	glm::quat backgroundRotation;            ///< wĩL[u}bv̉].
+	mutable GLState::Stats glStateStats;     ///< Õt[̏ԕύX̐.
 
 	std::unordered_map<std::string, TexturePtr> textureBuffer;
+	std::vector<TexturePtr> textureArrayList; ///< GeBeBp̃eNX`i[eNX`z.
 	Mesh::BufferPtr meshBuffer;
 	Entity::BufferPtr entityBuffer;
 	Font::Renderer fontRenderer;
 	Uniform::LightData lightData;
+	int lightCount = Uniform::fixedLightCount; ///< ̃t[̃Cg̐(AddLightŒǉCg܂).
+	LightCluster lightCluster; ///< Cgr[Ԃ̃NX^ɐU蕪.
+	UniformBufferPtr uboFrame;
+	Uniform::FrameData frameData = {};
 	CameraData camera;
 	std::mt19937 rand;
 	// lXȕϐi[ł@\ǉ(_ۑϐƂ).
@@ -19,24 +19,24 @@ namespace GameState {
 		EntityGroupId_Others
 	};
 
+	void UpdateSpaceSphere(double delta);
+
 	/// ^Cg.
 	class Title{
 	public:
-		explicit Title(Entity::Entity* p = nullptr) : pSpaceSphere(p) {}
 		void operator()(double delta);
 	private:
-		Entity::Entity* pSpaceSphere = nullptr;
+		bool hasSpaceSphere = false;
 		float timer = 0;
 	};
 
 	/// CQ[.
 	class MainGame{
 	public:
-		explicit MainGame(Entity::Entity*);
+		MainGame();
 		~MainGame();
 		void operator()(double delta);
 	private:
-		Entity::Entity* pSpaceSphere = nullptr;
 		Entity::Entity* pPlayer = nullptr;
 		double interval = 0;
 	};
@@ -0,0 +1,274 @@
+/**
+* @file GpuProfiler.cpp
+*/
+#include "GpuProfiler.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <iostream>
+
+namespace /* unnamed */ {
+
+	/// GpuProfiler::Statistics ɑΉNG̎.
+	const GLenum statisticsTargets[GpuProfiler::Statistics_Count] = {
+		GL_VERTICES_SUBMITTED_ARB,
+		GL_PRIMITIVES_SUBMITTED_ARB,
+		GL_CLIPPING_OUTPUT_PRIMITIVES_ARB,
+		GL_FRAGMENT_SHADER_INVOCATIONS_ARB,
+	};
+
+	/**
+	* NǦʂoĂ邩ׂ.
+	*
+	* @param query NGEIuWFNgID.
+	*
+	* @retval true  ʂoĂ.
+	* @retval false ܂ʂoĂȂ.
+	*/
+	bool IsAvailable(GLuint query){
+		GLuint isAvailable = GL_FALSE;
+		glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+		return isAvailable != GL_FALSE;
+	}
+
+	/**
+	* NǦʂ擾.
+	*
+	* @param query NGEIuWFNgID.
+	*
+	* @return NǦ.
+	*/
+	GLuint64 GetResult(GLuint query){
+		GLuint64 result = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+		return result;
+	}
+
+} // unnamed namespace
+
+/**
+* fXgN^.
+*/
+GpuProfiler::~GpuProfiler(){
+	for (Frame& frame : frameList) {
+		if (frame.elapsed) {
+			glDeleteQueries(1, &frame.elapsed);
+		}
+		for (Record& e : frame.recordList) {
+			glDeleteQueries(2, e.timestamp);
+			if (e.statistics[0]) {
+				glDeleteQueries(Statistics_Count, e.statistics);
+			}
+		}
+	}
+}
+
+/**
+* .
+*
+* @retval true  .
+* @retval false ^C}[ENGɑΉĂȂ. v͍sȂ.
+*/
+bool GpuProfiler::Init(){
+	if (isEnabled) {
+		return true;
+	}
+	if (!GLEW_VERSION_3_3 && !GLEW_ARB_timer_query) {
+		std::cerr << "WARNING: ^C}[ENGɑΉĂȂ߁AGPȔԂ͌v܂" << std::endl;
+		return false;
+	}
+	for (Frame& frame : frameList) {
+		glGenQueries(1, &frame.elapsed);
+	}
+	isStatisticsSupported = GLEW_ARB_pipeline_statistics_query != GL_FALSE;
+	frameResult.name = "Frame";
+	isEnabled = true;
+	return true;
+}
+
+/**
+* pCvCv̌vL܂͖ɂ.
+*
+* @param enable LɂȂtrue, ɂȂfalse.
+*
+* @retval true  ݒ萬.
+* @retval false GL_ARB_pipeline_statistics_queryɑΉĂȂ.
+*
+* pCvCṽNG͓qɂłȂ߁AԊŐԂv.
+*/
+bool GpuProfiler::PipelineStatistics(bool enable){
+	if (enable && !isStatisticsSupported) {
+		std::cerr << "WARNING: GL_ARB_pipeline_statistics_queryɑΉĂ܂" << std::endl;
+		return false;
+	}
+	isStatisticsEnabled = enable;
+	return true;
+}
+
+/**
+* t[̌vJn.
+*
+* @retval true  t[Ǒʂǂݏo.
+* @retval false ǂݏo錋ʂȂ.
+*
+* Oobt@Ăt[̌ʂoĂȂ΁AGPU҂ɂ̃t[̂Ă.
+*/
+bool GpuProfiler::BeginFrame(){
+	if (!isEnabled) {
+		return false;
+	}
+	Frame& frame = frameList[frameIndex];
+	bool hasResult = false;
+	if (frame.isIssued) {
+		hasResult = ReadFrame(frame);
+		if (!hasResult) {
+			++droppedFrameCount;
+		}
+		frame.isIssued = false;
+	}
+	frame.recordCount = 0;
+	depth = 0;
+	statisticsOwner = -1;
+	glBeginQuery(GL_TIME_ELAPSED, frame.elapsed);
+	isInFrame = true;
+	return hasResult;
+}
+
+/**
+* t[̌vI.
+*/
+void GpuProfiler::EndFrame(){
+	if (!isInFrame) {
+		return;
+	}
+	glEndQuery(GL_TIME_ELAPSED);
+	frameList[frameIndex].isIssued = true;
+	frameIndex = (frameIndex + 1) % frameCount;
+	isInFrame = false;
+}
+
+/**
+* Ԃ̎n_L^.
+*
+* @param name Ԗ.
+*
+* @return Ԃ̔ԍ. Endɓn. vȂꍇ-1.
+*/
+int GpuProfiler::Begin(const char* name){
+	if (!isInFrame) {
+		return -1;
+	}
+	Frame& frame = frameList[frameIndex];
+	if (frame.recordCount >= frame.recordList.size()) {
+		Record record = {};
+		glGenQueries(2, record.timestamp);
+		frame.recordList.push_back(record);
+	}
+	const int index = static_cast<int>(frame.recordCount++);
+	Record& record = frame.recordList[index];
+	record.name = name;
+	record.depth = depth++;
+	record.hasStatistics = false;
+	glQueryCounter(record.timestamp[0], GL_TIMESTAMP);
+	if (isStatisticsEnabled && statisticsOwner < 0) {
+		if (!record.statistics[0]) {
+			glGenQueries(Statistics_Count, record.statistics);
+		}
+		for (int i = 0; i < Statistics_Count; ++i) {
+			glBeginQuery(statisticsTargets[i], record.statistics[i]);
+		}
+		record.hasStatistics = true;
+		statisticsOwner = index;
+	}
+	return index;
+}
+
+/**
+* Ԃ̏I_L^.
+*
+* @param index BeginԂԂ̔ԍ.
+*/
+void GpuProfiler::End(int index){
+	if (index < 0 || !isInFrame) {
+		return;
+	}
+	Record& record = frameList[frameIndex].recordList[index];
+	if (statisticsOwner == index) {
+		for (int i = 0; i < Statistics_Count; ++i) {
+			glEndQuery(statisticsTargets[i]);
+		}
+		statisticsOwner = -1;
+	}
+	glQueryCounter(record.timestamp[1], GL_TIMESTAMP);
+	--depth;
+}
+
+/**
+* t[̌vʂǂݏo.
+*
+* @param frame ǂݏot[.
+*
+* @retval true  ǂݏo.
+* @retval false ܂ʂoĂȂNG.
+*/
+bool GpuProfiler::ReadFrame(Frame& frame){
+	if (!IsAvailable(frame.elapsed)) {
+		return false;
+	}
+	for (size_t i = 0; i < frame.recordCount; ++i) {
+		const Record& record = frame.recordList[i];
+		if (!IsAvailable(record.timestamp[1]) || (record.hasStatistics && !IsAvailable(record.statistics[Statistics_Count - 1]))) {
+			return false;
+		}
+	}
+
+	AddSample(frameResult, frameHistory, static_cast<double>(GetResult(frame.elapsed)) / 1000000.0);
+	for (size_t i = 0; i < frame.recordCount; ++i) {
+		const Record& record = frame.recordList[i];
+		auto itr = resultIndexMap.find(record.name);
+		if (itr == resultIndexMap.end()) {
+			itr = resultIndexMap.insert(std::make_pair(record.name, resultList.size())).first;
+			resultList.push_back(Result());
+			resultList.back().name = record.name;
+			historyList.push_back(History());
+		}
+		Result& result = resultList[itr->second];
+		result.depth = record.depth;
+		const GLuint64 begin = GetResult(record.timestamp[0]);
+		const GLuint64 end = GetResult(record.timestamp[1]);
+		AddSample(result, historyList[itr->second], static_cast<double>(end - begin) / 1000000.0);
+		result.hasStatistics = record.hasStatistics;
+		if (record.hasStatistics) {
+			for (int j = 0; j < Statistics_Count; ++j) {
+				result.statistics[j] = GetResult(record.statistics[j]);
+			}
+		}
+	}
+	return true;
+}
+
+/**
+* vԂǉAŏAρA99p[Z^CXV.
+*
+* @param result  XVv.
+* @param history ߂̎.
+* @param time    ǉ鎞(~b).
+*/
+void GpuProfiler::AddSample(Result& result, History& history, double time){
+	if (history.samples.size() < historySize) {
+		history.samples.push_back(time);
+	} else {
+		history.samples[history.next] = time;
+	}
+	history.next = (history.next + 1) % historySize;
+
+	sortBuffer.assign(history.samples.begin(), history.samples.end());
+	std::sort(sortBuffer.begin(), sortBuffer.end());
+	const size_t n = sortBuffer.size();
+	result.lastTime = time;
+	result.minTime = sortBuffer.front();
+	result.avgTime = std::accumulate(sortBuffer.begin(), sortBuffer.end(), 0.0) / static_cast<double>(n);
+	const size_t p99 = static_cast<size_t>(std::ceil(static_cast<double>(n) * 0.99));
+	result.p99Time = sortBuffer[std::max<size_t>(p99, 1) - 1];
+	result.sampleCount = n;
+}
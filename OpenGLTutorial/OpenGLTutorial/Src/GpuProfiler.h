@@ -0,0 +1,130 @@
+/**
+* @file GpuProfiler.h
+*/
+#ifndef GPUPROFILER_H_INCLUDED
+#define GPUPROFILER_H_INCLUDED
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/**
+* `ԂƂGPȔԂvNX.
+*
+* t[ŜGL_TIME_ELAPSEDAeԂ̎n_ƏI_GL_TIMESTAMP̃NGŌv.
+* NG̓t[Pʂ̃Oobt@ɔsAt[ɌʂǂݏôŁA
+* ǂݏô߂GPU҂Ƃ͂Ȃ. ʂԂɍȂt[͎̂Ă.
+*/
+class GpuProfiler{
+public:
+	/// pCvCv̎.
+	enum Statistics {
+		Statistics_VerticesSubmitted, ///< ͂ꂽ_.
+		Statistics_PrimitivesSubmitted, ///< ͂ꂽv~eBu.
+		Statistics_ClippingOutputPrimitives, ///< NbsÕv~eBu.
+		Statistics_FragmentShaderInvocations, ///< tOgVF[_̎s.
+		Statistics_Count,
+	};
+
+	/**
+	* Ԃ̌v.
+	*
+	* Ԃ̒Pʂ̓~b. min, avg, p99 ͒ historySize t[̒l.
+	*/
+	struct Result {
+		std::string name; ///< Ԗ.
+		int depth = 0; ///< Ԃ̓q̐[.
+		double lastTime = 0; ///< Ōɓǂݏo.
+		double minTime = 0; ///< ŏ̎.
+		double avgTime = 0; ///< ς̎.
+		double p99Time = 0; ///< 99p[Z^C̎.
+		size_t sampleCount = 0; ///< min, avg, p99 ̌vZɎgt[.
+		bool hasStatistics = false; ///< statisticsLȂtrue.
+		GLuint64 statistics[Statistics_Count] = {}; ///< ŌɓǂݏopCvCv.
+	};
+
+	/**
+	* Ԃ̎n_ƏI_v邽߂̃NX.
+	*
+	* 쐬ƂɎn_AjƂɏI_L^.
+	*/
+	class Scope {
+	public:
+		Scope(GpuProfiler& p, const char* name) : profiler(p), index(p.Begin(name)) {}
+		~Scope() { profiler.End(index); }
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		GpuProfiler& profiler;
+		int index;
+	};
+
+	GpuProfiler() = default;
+	~GpuProfiler();
+	GpuProfiler(const GpuProfiler&) = delete;
+	GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+	bool Init();
+	bool IsEnabled() const { return isEnabled; }
+	bool PipelineStatistics(bool enable);
+
+	bool BeginFrame();
+	void EndFrame();
+	int Begin(const char* name);
+	void End(int index);
+
+	const Result& FrameResult() const { return frameResult; }
+	const std::vector<Result>& Results() const { return resultList; }
+	size_t DroppedFrameCount() const { return droppedFrameCount; }
+
+private:
+	/// 1̋ԂɔsNG.
+	struct Record {
+		std::string name;
+		int depth;
+		GLuint timestamp[2]; ///< n_ƏI_GL_TIMESTAMPNG.
+		bool hasStatistics; ///< pCvCvvtrue.
+		GLuint statistics[Statistics_Count]; ///< pCvCṽNG(gȂ0).
+	};
+
+	/// 1t[ɔsNG.
+	struct Frame {
+		GLuint elapsed = 0; ///< t[ŜGL_TIME_ELAPSEDNG.
+		bool isIssued = false; ///< ʂǂݏoĂȂtrue.
+		std::vector<Record> recordList; ///< Ԃ̃NG. Õt[̂̂ėp.
+		size_t recordCount = 0; ///< ̃t[ŎgrecordList̗vf.
+	};
+
+	/// ԂƂ̒߂̎.
+	struct History {
+		std::vector<double> samples;
+		size_t next = 0; ///< ɏsamples̈ʒu.
+	};
+
+	bool ReadFrame(Frame& frame);
+	void AddSample(Result& result, History& history, double time);
+
+private:
+	static const int frameCount = 4; ///< ʂ҂Ԃɔsłt[̐.
+	static const size_t historySize = 120; ///< min, avg, p99 ̌vZɎgt[.
+
+	bool isEnabled = false;
+	bool isStatisticsSupported = false;
+	bool isStatisticsEnabled = false;
+	Frame frameList[frameCount];
+	int frameIndex = 0; ///< ݂̃t[gframeList̔ԍ.
+	bool isInFrame = false; ///< BeginFrameEndFrame̊ԂȂtrue.
+	int depth = 0; ///< ݂̋Ԃ̓q̐[.
+	int statisticsOwner = -1; ///< pCvCvv̋Ԃ̔ԍ(vłȂ-1).
+	size_t droppedFrameCount = 0; ///< ʂԂɍ킸Ɏ̂Ăt[̐.
+
+	Result frameResult; ///< t[Ŝ̌v.
+	History frameHistory;
+	std::vector<Result> resultList; ///< ԂƂ̌v. ŏɌvɕ.
+	std::vector<History> historyList;
+	std::unordered_map<std::string, size_t> resultIndexMap; ///< ԖresultList̔ԍ𓾂邽߂̕\.
+	std::vector<double> sortBuffer; ///< p[Z^C߂邽߂̍Ɨ̈.
+};
+
+#endif // GPUPROFILER_H_INCLUDED
@@ -0,0 +1,248 @@
+/**
+* @file LightCluster.cpp
+*/
+#include "LightCluster.h"
+#include "GLState.h"
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+#include <iostream>
+
+namespace /* unnamed */ {
+
+	/// Cg̖邳̒l鋗ACg̉e͈͂Ƃ.
+	const float lightCutoff = 0.01f;
+
+	/**
+	* NX^̔ԍvZ.
+	*
+	* @param x ^C̉̔ԍ.
+	* @param y ^C̏c̔ԍ.
+	* @param z XCX̔ԍ.
+	*
+	* @return NX^̔ԍ.
+	*/
+	int ClusterIndex(int x, int y, int z){
+		return (z * LightCluster::tileCountY + y) * LightCluster::tileCountX + x;
+	}
+
+	/**
+	* KfoCXW͈̔͂^C͈̔͂ɕϊ.
+	*
+	* @param minNdc    ͈͂̍ŏl.
+	* @param maxNdc    ͈͂̍ől.
+	* @param tileCount ^C̐.
+	* @param minTile   ŏ̃^Cԍi[ϐ.
+	* @param maxTile   ő̃^Cԍi[ϐ.
+	*
+	* @retval true  ͈͂ʓɂ.
+	* @retval false ͈͂ʊOɂ.
+	*/
+	bool NdcToTile(float minNdc, float maxNdc, int tileCount, int& minTile, int& maxTile){
+		if (maxNdc < -1 || minNdc > 1) {
+			return false;
+		}
+		minTile = std::max(0, static_cast<int>(std::floor((minNdc * 0.5f + 0.5f) * tileCount)));
+		maxTile = std::min(tileCount - 1, static_cast<int>(std::floor((maxNdc * 0.5f + 0.5f) * tileCount)));
+		return true;
+	}
+
+} // unnamed namespace
+
+/**
+* fXgN^.
+*/
+LightCluster::~LightCluster(){
+	if (indexTexture) {
+		glDeleteTextures(1, &indexTexture);
+	}
+	if (gridTexture) {
+		glDeleteTextures(1, &gridTexture);
+	}
+}
+
+/**
+* .
+*
+* @retval true  .
+* @retval false s.
+*/
+bool LightCluster::Init(){
+	if (gridTexture) {
+		return true;
+	}
+	gridBuffer.Init(GL_TEXTURE_BUFFER, clusterCount * 2 * sizeof(GLushort), nullptr, GL_DYNAMIC_DRAW);
+	indexBuffer.Init(GL_TEXTURE_BUFFER, maxIndexCount * sizeof(GLushort), nullptr, GL_DYNAMIC_DRAW);
+	if (!gridBuffer.Id() || !indexBuffer.Id()) {
+		std::cerr << "ERROR: CgNX^̃obt@̍쐬Ɏs" << std::endl;
+		return false;
+	}
+	glGenTextures(1, &gridTexture);
+	GLState::BindTexture(gridUnit, GL_TEXTURE_BUFFER, gridTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RG16UI, gridBuffer.Id());
+	glGenTextures(1, &indexTexture);
+	GLState::BindTexture(indexUnit, GL_TEXTURE_BUFFER, indexTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_R16UI, indexBuffer.Id());
+
+	gridData.resize(clusterCount * 2);
+	cursorList.resize(clusterCount);
+	indexData.reserve(maxIndexCount);
+	return true;
+}
+
+/**
+* CgNX^ɐU蕪AʂGPUɓ].
+*
+* @param lights  Cg̔z. position.w̓Cg̉e͈(0ȉȂ疳ȃCg).
+* @param count   Cg̐.
+* @param matView r[s.
+* @param matProj vWFNVs(glm::perspectiveō쐬).
+*
+* Cg̉e͈͂̋͂ރr[Wn̔ʂɓeAdȂ^CƃXCX̑SĂɓo^.
+* NX^Ƃ̃Cg𐔂ĂJnʒu߁ACgԍl߂ď.
+*/
+void LightCluster::Build(const Uniform::PointLight* lights, size_t count, const glm::mat4& matView, const glm::mat4& matProj){
+	if (!gridTexture) {
+		return;
+	}
+	stats = Stats();
+	nearPlane = matProj[3][2] / (matProj[2][2] - 1.0f);
+	farPlane = matProj[3][2] / (matProj[2][2] + 1.0f);
+
+	// CgƂɉeNX^͈̔͂߁ANX^Ƃ̃Cg𐔂.
+	rangeList.clear();
+	std::fill(cursorList.begin(), cursorList.end(), 0);
+	for (size_t i = 0; i < count; ++i) {
+		const float radius = lights[i].position.w;
+		if (radius <= 0) {
+			continue;
+		}
+		const glm::vec4 center = matView * glm::vec4(glm::vec3(lights[i].position), 1);
+		const float depth = -center.z;
+		const float minDepth = std::max(depth - radius, nearPlane);
+		const float maxDepth = std::min(depth + radius, farPlane);
+		if (minDepth > maxDepth) {
+			continue;
+		}
+		// ̎l߂ʂƉʂœe΁Ae͈̔͂SĊ܂.
+		glm::vec2 minNdc(1e10f);
+		glm::vec2 maxNdc(-1e10f);
+		for (float d : { minDepth, maxDepth }) {
+			for (float sign : { -1.0f, 1.0f }) {
+				const glm::vec2 ndc((center.x + radius * sign) * matProj[0][0] / d, (center.y + radius * sign) * matProj[1][1] / d);
+				minNdc = glm::min(minNdc, ndc);
+				maxNdc = glm::max(maxNdc, ndc);
+			}
+		}
+		LightRange range;
+		range.index = static_cast<GLushort>(i);
+		if (!NdcToTile(minNdc.x, maxNdc.x, tileCountX, range.minX, range.maxX) ||
+			!NdcToTile(minNdc.y, maxNdc.y, tileCountY, range.minY, range.maxY)) {
+			continue;
+		}
+		range.minZ = Slice(minDepth);
+		range.maxZ = Slice(maxDepth);
+		for (int z = range.minZ; z <= range.maxZ; ++z) {
+			for (int y = range.minY; y <= range.maxY; ++y) {
+				for (int x = range.minX; x <= range.maxX; ++x) {
+					++cursorList[ClusterIndex(x, y, z)];
+				}
+			}
+		}
+		rangeList.push_back(range);
+	}
+	stats.lightCount = rangeList.size();
+
+	// Cg̗ݐϘaJnʒu߂. 肫ȂCgԍ͎̂Ă.
+	size_t offset = 0;
+	size_t requestCount = 0;
+	for (int i = 0; i < clusterCount; ++i) {
+		const size_t n = std::min<size_t>(cursorList[i], maxIndexCount - offset);
+		requestCount += cursorList[i];
+		gridData[i * 2 + 0] = static_cast<GLushort>(offset);
+		gridData[i * 2 + 1] = static_cast<GLushort>(n);
+		cursorList[i] = static_cast<GLushort>(offset);
+		stats.maxClusterLightCount = std::max(stats.maxClusterLightCount, n);
+		offset += n;
+	}
+	stats.indexCount = offset;
+	stats.overflowCount = requestCount - offset;
+
+	indexData.resize(offset);
+	for (const LightRange& range : rangeList) {
+		for (int z = range.minZ; z <= range.maxZ; ++z) {
+			for (int y = range.minY; y <= range.maxY; ++y) {
+				for (int x = range.minX; x <= range.maxX; ++x) {
+					const int cluster = ClusterIndex(x, y, z);
+					if (cursorList[cluster] < gridData[cluster * 2] + gridData[cluster * 2 + 1]) {
+						indexData[cursorList[cluster]++] = range.index;
+					}
+				}
+			}
+		}
+	}
+
+	// Õt[̕`悪QƂĂ邩Ȃ̂ŁAobt@ۂƏ.
+	if (void* p = gridBuffer.MapBuffer(GL_TEXTURE_BUFFER, gridData.size() * sizeof(GLushort))) {
+		memcpy(p, gridData.data(), gridData.size() * sizeof(GLushort));
+		gridBuffer.UnmapBuffer(GL_TEXTURE_BUFFER);
+	}
+	if (!indexData.empty()) {
+		if (void* p = indexBuffer.MapBuffer(GL_TEXTURE_BUFFER, indexData.size() * sizeof(GLushort))) {
+			memcpy(p, indexData.data(), indexData.size() * sizeof(GLushort));
+			indexBuffer.UnmapBuffer(GL_TEXTURE_BUFFER);
+		}
+	}
+}
+
+/**
+* VF[_NX^߂邽߂̃p[^쐬.
+*
+* @param viewportWidth  3DV[̕`͈͂̕.
+* @param viewportHeight 3DV[̕`͈͂̍.
+*
+* @return LightDataɐݒ肷p[^.
+*/
+Uniform::ClusterData LightCluster::Data(int viewportWidth, int viewportHeight) const{
+	const float sliceScale = static_cast<float>(sliceCount) / std::log(farPlane / nearPlane);
+	Uniform::ClusterData data;
+	data.tileScale = glm::vec4(
+		static_cast<float>(tileCountX) / static_cast<float>(viewportWidth),
+		static_cast<float>(tileCountY) / static_cast<float>(viewportHeight),
+		sliceScale, -std::log(nearPlane) * sliceScale);
+	data.depthParams = glm::vec4(nearPlane * farPlane, farPlane, farPlane - nearPlane, 0);
+	data.count = glm::uvec4(tileCountX, tileCountY, sliceCount, 0);
+	return data;
+}
+
+/**
+* NX^̃obt@eNX`Œ̃eNX`EC[WEjbgɊ蓖Ă.
+*/
+void LightCluster::Bind() const{
+	GLState::BindTexture(gridUnit, GL_TEXTURE_BUFFER, gridTexture);
+	GLState::BindTexture(indexUnit, GL_TEXTURE_BUFFER, indexTexture);
+}
+
+/**
+* Cg̉e͈͂߂.
+*
+* @param color Cg̖邳.
+*
+* @return 邳lightCutoff܂ŉ鋗.
+*/
+float LightCluster::Range(const glm::vec4& color){
+	const float intensity = std::max(color.x, std::max(color.y, color.z));
+	return intensity > 0 ? std::sqrt(intensity / lightCutoff) : 0.0f;
+}
+
+/**
+* r[Wn̐[xXCX̔ԍ߂.
+*
+* @param depth r[Wn̐[x(̒l).
+*
+* @return XCX̔ԍ.
+*/
+int LightCluster::Slice(float depth) const{
+	const float s = std::log(depth / nearPlane) * static_cast<float>(sliceCount) / std::log(farPlane / nearPlane);
+	return std::min(sliceCount - 1, std::max(0, static_cast<int>(std::floor(s))));
+}
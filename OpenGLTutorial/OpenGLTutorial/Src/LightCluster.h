@@ -0,0 +1,79 @@
+/**
+* @file LightCluster.h
+*/
+#ifndef LIGHTCLUSTER_H_INCLUDED
+#define LIGHTCLUSTER_H_INCLUDED
+#include <GL/glew.h>
+#include "BufferObject.h"
+#include "Uniform.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+* _r[Ԃ̃NX^ɐU蕪NX.
+*
+* ʂ^CɁA̐[xΐœԊũXCXɕȎ(NX^)ƂɁA
+* e郉Cg̔ԍ̃Xg𖈃t[CPUō쐬Aobt@eNX`ŃVF[_ɓn.
+* tOgVF[_͎̃NX^̃CgvZ΂悢̂ŁA
+* Cg̐Ă1f̌vZʂ͂قƂǑȂ.
+*/
+class LightCluster{
+public:
+	/**
+	* OBuilď.
+	*/
+	struct Stats {
+		size_t lightCount = 0; ///< ƌCg̐.
+		size_t indexCount = 0; ///< NX^ɓo^Cgԍ̑.
+		size_t maxClusterLightCount = 0; ///< 1̃NX^ɓo^ꂽCg̍ő吔.
+		size_t overflowCount = 0; ///< o^ꂸɎ̂ĂCgԍ̐.
+	};
+
+	static const int tileCountX = 16; ///< ʂ̉̃^C.
+	static const int tileCountY = 12; ///< ʂ̏c̃^C.
+	static const int sliceCount = 16; ///< [x̃XCX.
+	static const int clusterCount = tileCountX * tileCountY * sliceCount; ///< NX^̑.
+	static const size_t maxIndexCount = 16 * 1024; ///< SNX^ɓo^ł郉Cgԍ̑.
+	static const GLuint gridUnit = 14; ///< NX^Ƃ̃Cg͈̔͂蓖ĂeNX`EC[WEjbg.
+	static const GLuint indexUnit = 15; ///< Cgԍ̃Xg蓖ĂeNX`EC[WEjbg.
+
+	LightCluster() = default;
+	~LightCluster();
+	LightCluster(const LightCluster&) = delete;
+	LightCluster& operator=(const LightCluster&) = delete;
+
+	bool Init();
+	void Build(const Uniform::PointLight* lights, size_t count, const glm::mat4& matView, const glm::mat4& matProj);
+	Uniform::ClusterData Data(int viewportWidth, int viewportHeight) const;
+	void Bind() const;
+	const Stats& GetStats() const { return stats; }
+
+	static float Range(const glm::vec4& color);
+
+private:
+	int Slice(float depth) const;
+
+	/// CgeNX^͈̔.
+	struct LightRange {
+		GLushort index; ///< Cg̔ԍ.
+		int minX, maxX; ///< ^C͈̉̔.
+		int minY, maxY; ///< ^C̏c͈̔.
+		int minZ, maxZ; ///< XCX͈̔.
+	};
+
+private:
+	BufferObject gridBuffer; ///< NX^Ƃ(CgԍXg̊Jnʒu, Cg).
+	BufferObject indexBuffer; ///< NX^Ƃ̃Cgԍ̃Xg.
+	GLuint gridTexture = 0;
+	GLuint indexTexture = 0;
+
+	float nearPlane = 1; ///< OBuildɓnꂽvWFNVs̋߃Nbv.
+	float farPlane = 200; ///< OBuildɓnꂽvWFNVs̉Nbv.
+	std::vector<LightRange> rangeList;
+	std::vector<GLushort> gridData; ///< gridBufferɓ]f[^.
+	std::vector<GLushort> indexData; ///< indexBufferɓ]f[^.
+	std::vector<GLushort> cursorList; ///< CgԍނƂ̃NX^Ƃ݈̏ʒu.
+	Stats stats;
+};
+
+#endif // LIGHTCLUSTER_H_INCLUDED
@@ -4,37 +4,110 @@
 
 #include "GameEngine.h"
 #include "GameState.h"
+#include "GLRecorder.h"
 #include "../Res/Audio/SampleSound_acf.h"
 #include "../Res/Audio/SampleCueSheet.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <random>
+#include <iostream>
+#include <string.h>
+#include <stdlib.h>
 
 
-/// Gg[|Cg
-int main() {
+/**
+* Gg[|Cg.
+*
+* u--headless t[vw肷ƁAEBhE\ɃQ[{҂wt[(ȗ600)sA
+* t[Ԃ̓vƍŌ̃t[̃nbVlo͂ďI.
+* EBhE\ȂȂ̂ŁAXWaylandȂǂ̃EBhEVXe͕Kv.
+* u--float-vertexvw肷ƁAbV̒_f[^kɊi[.
+*
+* OpenGĽĂяoL^IvV:
+* - u--gl-statsv 1t[̌Ăяo񐔂ނƂɏo͂.
+* - u--gl-trace t@Cv 1t[̌Ăяot@Cɏo.
+*   wbhXȂŌ̃t[AłȂ΍ŏ̃t[o.
+* - u--gl-replay t@Cv wbhX̎sɃg[XĎsA摜̃nbVlv邩ׂ.
+*/
+int main(int argc, char* argv[]) {
+	int headlessFrameCount = 0;
+	bool isGLStatsEnabled = false;
+	const char* traceFilename = nullptr;
+	const char* replayFilename = nullptr;
+	Mesh::VertexFormat vertexFormat = Mesh::VertexFormat::Packed;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--headless") == 0) {
+			// t[͏ȗł̂ŁÄ̐̂Ƃg.
+			headlessFrameCount = 600;
+			if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+				headlessFrameCount = atoi(argv[++i]);
+			}
+		} else if (strcmp(argv[i], "--gl-stats") == 0) {
+			isGLStatsEnabled = true;
+		} else if (strcmp(argv[i], "--gl-trace") == 0 && i + 1 < argc) {
+			traceFilename = argv[++i];
+		} else if (strcmp(argv[i], "--gl-replay") == 0 && i + 1 < argc) {
+			replayFilename = argv[++i];
+		} else if (strcmp(argv[i], "--float-vertex") == 0) {
+			vertexFormat = Mesh::VertexFormat::Float;
+		}
+	}
+	const bool isHeadless = headlessFrameCount > 0;
+
 	GameEngine& game = GameEngine::Instance();
-	if (!game.Init(800, 600, "OpenGL Tutorial")) {
+	if (!game.Init(800, 600, "OpenGL Tutorial",
+		isHeadless ? GLFWEW::ContextType::Headless : GLFWEW::ContextType::Window, vertexFormat)) {
 		return 1;
 	}
+	if (isGLStatsEnabled || traceFilename) {
+		GLRecorder::Enable();
+		if (traceFilename) {
+			GLRecorder::CaptureFrame(traceFilename, isHeadless ? headlessFrameCount - 1 : 0);
+		}
+	}
+	if (!isHeadless) {
+		// ׂƂ3DV[̉𑜓x60fpsۂ.
+		// wbhXł͖񓯂摜ɂȂ悤ɉ𑜓xŒ肷.
+		game.DynamicResolution(true);
 
-	// I[fBȈ.
-	if (!game.InitAudio("Res/Audio/SampleSound.acf", "Res/Audio/SampleCueSheet.acb",
-		nullptr, CRI_SAMPLESOUND_ACF_DSPSETTING_DSPBUSSETTING_0)) {
-		return 1;
+		// I[fBȈ.
+		if (!game.InitAudio("Res/Audio/SampleSound.acf", "Res/Audio/SampleCueSheet.acb",
+			nullptr, CRI_SAMPLESOUND_ACF_DSPSETTING_DSPBUSSETTING_0)) {
+			return 1;
+		}
 	}
 
 	// t@Cǂݍ
+	// GeBeB̃eNX`͓傫Ȃ̂ŁAeNX`zɂ܂Ƃ߂ĕ`Pʂ炷.
+	// wi̓L[u}bv̍쐬2DeNX`ƂĎĝŁAeNX`zɂȂ.
 	game.LoadTextureFromFile("Res/SpaceSphere.bmp");
-	game.LoadTextureFromFile("Res/Toroid.bmp");
-	game.LoadTextureFromFile("Res/Toroid.Normal.bmp");
+	game.LoadTextureFromFile("Res/Toroid.bmp", true);
+	game.LoadTextureFromFile("Res/Toroid.Normal.bmp", true);
 	game.LoadTextureFromFile("Res/Dummy.Normal.bmp");
-	game.LoadTextureFromFile("Res/Player.bmp");
+	game.LoadTextureFromFile("Res/Player.bmp", true);
 	game.LoadMeshFromFile("Res/SpaceSphere.fbx");//if
 	game.LoadMeshFromFile("Res/Toroid.fbx");
 	game.LoadMeshFromFile("Res/Player.fbx");
 	game.LoadMeshFromFile("Res/Blast.fbx");//p̃bV
 	game.LoadFontFromFile("Res/UniNeue.fnt");//tHgt@C
 
+	if (isHeadless) {
+		// ͂ȂĂ`敉ׂ悤ɁA^Cgʂ΂ăQ[{҂n߂.
+		// wĩL[u}bv̓^Cgʂō쐬Ă̂ŁAō쐬Ă.
+		game.BakeBackground("SpaceSphere", "Res/SpaceSphere.bmp");
+		game.UpdateFunc(GameState::MainGame());
+		game.Run(headlessFrameCount);
+		if (replayFilename) {
+			// Ō̃t[ƓԂĎŝŁAL^sƓ摜ɂȂ͂.
+			if (!GLRecorder::Replay(replayFilename)) {
+				return 1;
+			}
+			const uint64_t hash = game.CalcFrameHash();
+			std::cout << "GLRecorder: Ďs摜̃nbVl" <<
+				(hash == game.FrameHash() ? "v܂" : "v܂ł") << std::endl;
+			return hash == game.FrameHash() ? 0 : 1;
+		}
+		return 0;
+	}
 	game.UpdateFunc(GameState::Title());
 	game.Run();
 	return 0;
@@ -50,6 +50,8 @@ namespace GameState {
 				entity.Destroy();
 				return;
 			}
+			// e̎Ƃ炷.
+			GameEngine::Instance().AddLight(pos, glm::vec3(2.0f, 1.6f, 0.8f));
 		}
 	};
 
@@ -79,6 +81,8 @@ namespace GameState {
 			const glm::vec4 col1 = color[static_cast<int>(variation) + 1];
 			const glm::vec4 newColor = glm::mix(col0, col1, std::fmod(variation, 1));
 			entity.Color(newColor);
+			// ͎̌Ԍo߂ŎキȂ.
+			GameEngine::Instance().AddLight(entity.Position(), glm::vec3(12.0f, 6.0f, 2.0f) * static_cast<float>(1 - timer * 2));
 
 			// Y܂b60x̑xŉ].
 			glm::vec3 euler = glm::eulerAngles(entity.Rotation());
@@ -165,9 +169,11 @@ namespace GameState {
 		// G@̈ʒuɔGeBeB𔭐
 		GameEngine& game = GameEngine::Instance();
 		if (Entity::Entity* p = game.AddEntity(EntityGroupId_Others, rhs.Position(),
-			"Blast", "Res/Toroid.bmp", UpdateBlast())) {
+			"Blast", "Res/Toroid.bmp", UpdateBlast(), "NonLighting")) {
 			const std::uniform_real_distribution<float> rotRange(0.0f, glm::pi<float>() * 2);
 			p->Rotation(glm::quat(glm::vec3(0, rotRange(game.Rand()), 0)));
+			// Ԍo߂œɂȂ̂ŁAȌɃuh.
+			p->Queue(Entity::RenderQueue::Transparent);
 
 			// _Z(GĂ100_Z).
 			game.UserVariable("score") += 100;
@@ -197,7 +203,7 @@ namespace GameState {
 	}
 
 	// RXgN^.
-	MainGame::MainGame(Entity::Entity* p) : pSpaceSphere(p) {
+	MainGame::MainGame() {
 
 		GameEngine& game = GameEngine::Instance();
 
@@ -218,6 +224,7 @@ namespace GameState {
 	/// ^Cgʂ̍XV.
 	void MainGame::operator()(double delta){
 		GameEngine& game = GameEngine::Instance();
+		UpdateSpaceSphere(delta);
 
 		// @쐬R[h
 		if (!pPlayer) {
@@ -251,5 +258,10 @@ namespace GameState {
 		char str[16];
 		snprintf(str, 16, "%08.0f", game.UserVariable("score"));
 		game.AddString(glm::vec2(-0.2f, 1.0f), str);
+		// 𑜓xĂƂ́Å\.
+		if (game.ResolutionScale() < 1.0f) {
+			snprintf(str, 16, "RES %3.0f%%", game.ResolutionScale() * 100.0f);
+			game.AddString(glm::vec2(-1.0f, -0.9f), str);
+		}
 	}
 }
\ No newline at end of file
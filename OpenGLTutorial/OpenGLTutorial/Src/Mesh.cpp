@@ -2,8 +2,16 @@
 * @file Mesh.cpp
 */
 #include "Mesh.h"
+#include "GLState.h"
+#include "MeshSimplify.h"
+#include "MeshOptimize.h"
+#include <glm/gtc/packing.hpp>
 #include <fbxsdk.h>
 #include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <string.h>
 
 /**
 * ff[^Ǘ̂߂̖O.
@@ -18,6 +26,94 @@ namespace Mesh {
 		glm::vec3 normal; ///< @
 		glm::vec4 tangent; ///< ڃxNg
 	};
+	static_assert(sizeof(Vertex) == 64, "VertexɋlߕĂ܂");
+
+	/**
+	* SĂ̗vfv钸_܂Ƃ߂邽߂̃nbV֐.
+	*
+	* Vertexɂ͋lߕȂ̂ŁAoCgƂFNV-1aŃnbVl߂.
+	*/
+	struct VertexHash{
+		size_t operator()(const Vertex& v) const {
+			const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+			uint32_t hash = 2166136261u;
+			for (size_t i = 0; i < sizeof(Vertex); ++i) {
+				hash = (hash ^ p[i]) * 16777619u;
+			}
+			return hash;
+		}
+	};
+
+	/**
+	* SĂ̗vfv钸_܂Ƃ߂邽߂̔r֐.
+	*/
+	struct VertexEqual{
+		bool operator()(const Vertex& a, const Vertex& b) const {
+			return memcmp(&a, &b, sizeof(Vertex)) == 0;
+		}
+	};
+
+	/**
+	* k_f[^^.
+	*
+	* FƖ@͔͈͂܂Ă̂ŁAKŊi[.
+	* eNX`W͌JԂ̂߂0`1z邱Ƃ̂ŁAx_Ŋi[.
+	* W̓[hϊKpς݂Œl͈̔͂L߁AkȂ.
+	*/
+	struct PackedVertex{
+		glm::vec3 position; ///< W.
+		glm::uint32 color; ///< F(packUnorm4x8RGBA8rbgl߂).
+		glm::uint32 texCoord; ///< eNX`W(packHalf2x16ŋl߂).
+		glm::uint32 normal; ///< @(packSnorm3x10_1x2ŋl߂).
+		glm::uint32 tangent; ///< ڃxNg(packSnorm3x10_1x2ŋl߂. w͏]@̌).
+	};
+	static_assert(sizeof(PackedVertex) == 28, "PackedVertex̃TCYzƈقȂ܂");
+
+	/**
+	* _f[^k.
+	*
+	* @param v k钸_f[^.
+	*
+	* @return k_f[^.
+	*/
+	PackedVertex Pack(const Vertex& v){
+		PackedVertex p;
+		p.position = v.position;
+		p.color = glm::packUnorm4x8(v.color);
+		p.texCoord = glm::packHalf2x16(v.texCoord);
+		p.normal = glm::packSnorm3x10_1x2(glm::vec4(v.normal, 0));
+		p.tangent = glm::packSnorm3x10_1x2(glm::vec4(glm::vec3(v.tangent), v.tangent.w < 0 ? -1.0f : 1.0f));
+		return p;
+	}
+
+	/**
+	* _Agr[ǧ`.
+	*/
+	struct VertexAttribute{
+		GLuint index; ///< _Agr[g̃CfbNX.
+		GLint size; ///< vf.
+		GLenum type; ///< vf̃f[^^.
+		GLboolean normalized; ///< 0`1܂-1`1̕_ɕϊȂGL_TRUE.
+		size_t offset; ///< _f[^̐擪̃oCgItZbg.
+	};
+
+	/// Vertex ̒_Agr[g.
+	const VertexAttribute vertexAttributeList[] = {
+		{ 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position) },
+		{ 1, 4, GL_FLOAT, GL_FALSE, offsetof(Vertex, color) },
+		{ 2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texCoord) },
+		{ 3, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal) },
+		{ 4, 4, GL_FLOAT, GL_FALSE, offsetof(Vertex, tangent) },
+	};
+
+	/// PackedVertex ̒_Agr[g. _VF[_ɂVertexƓ^œn.
+	const VertexAttribute packedVertexAttributeList[] = {
+		{ 0, 3, GL_FLOAT, GL_FALSE, offsetof(PackedVertex, position) },
+		{ 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(PackedVertex, color) },
+		{ 2, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(PackedVertex, texCoord) },
+		{ 3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(PackedVertex, normal) },
+		{ 4, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(PackedVertex, tangent) },
+	};
 
 	/**
 	* Vertex Buffer Object 쐬.
@@ -57,41 +153,46 @@ namespace Mesh {
 	/**
 	* _Agr[gݒ肷.
 	*
-	* @param index _Agr[g̃CfbNX.
-	* @param cls   _f[^^.
-	* @param mbr   _Agr[gɐݒ肷 cls ̃oϐ.
+	* @param begin  ݒ肷钸_Agr[gz̐擪.
+	* @param end    ݒ肷钸_Agr[gz̏I[.
+	* @param stride 1_̃oCg.
 	*/
-	#define SetVertexAttribPointer(index, cls, mbr) SetVertexAttribPointerI( \
-		index, \
-		sizeof(cls::mbr) / sizeof(float), \
-		sizeof(cls), \
-		reinterpret_cast<GLvoid*>(offsetof(cls, mbr)))
-
-	void SetVertexAttribPointerI(GLuint index, GLint size, GLsizei stride, const GLvoid* pointer) {
-		glEnableVertexAttribArray(index);
-		glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, stride, pointer);
+	void SetVertexAttribPointer(const VertexAttribute* begin, const VertexAttribute* end, GLsizei stride){
+		for (const VertexAttribute* p = begin; p != end; ++p) {
+			glEnableVertexAttribArray(p->index);
+			glVertexAttribPointer(p->index, p->size, p->type, p->normalized, stride, reinterpret_cast<GLvoid*>(p->offset));
+		}
 	}
 
 	/**
 	* Vertex Array Object쐬.
 	*
-	* @param vbo VAOɊ֘AtVBO.
-	* @param ibo VAOɊ֘AtIBO.
+	* @param vbo             VAOɊ֘AtVBO.
+	* @param ibo             VAOɊ֘AtIBO.
+	* @param drawIndexBuffer VAOɊ֘At`CfbNXpVBO. 0Ȃ֘AtȂ.
+	* @param format          vboɊi[钸_f[^̌`.
 	*
 	* @return 쐬VAO.
 	*/
-	GLuint CreateVAO(GLuint vbo, GLuint ibo){
+	GLuint CreateVAO(GLuint vbo, GLuint ibo, GLuint drawIndexBuffer, VertexFormat format){
 		GLuint vao = 0;
 		glGenVertexArrays(1, &vao);
-		glBindVertexArray(vao);
+		GLState::BindVertexArray(vao);
 		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		SetVertexAttribPointer(0, Vertex, position);
-		SetVertexAttribPointer(1, Vertex, color);
-		SetVertexAttribPointer(2, Vertex, texCoord);
-		SetVertexAttribPointer(3, Vertex, normal);
-		SetVertexAttribPointer(4, Vertex, tangent);
+		if (format == VertexFormat::Packed) {
+			SetVertexAttribPointer(std::begin(packedVertexAttributeList), std::end(packedVertexAttributeList), sizeof(PackedVertex));
+		} else {
+			SetVertexAttribPointer(std::begin(vertexAttributeList), std::end(vertexAttributeList), sizeof(Vertex));
+		}
+		if (drawIndexBuffer) {
+			// `CfbNX̓CX^XƂɐiނ߁AbaseInstance + gl_InstanceID ̒lɂȂ.
+			glBindBuffer(GL_ARRAY_BUFFER, drawIndexBuffer);
+			glEnableVertexAttribArray(drawIndexAttribute);
+			glVertexAttribIPointer(drawIndexAttribute, 1, GL_UNSIGNED_INT, sizeof(GLuint), nullptr);
+			glVertexAttribDivisor(drawIndexAttribute, 1);
+		}
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-		glBindVertexArray(0);
+		GLState::BindVertexArray(0);
 
 		return vao;
 	}
@@ -194,6 +295,7 @@ namespace Mesh {
 		std::vector<uint32_t> indexBuffer;
 		std::vector<Vertex> vertexBuffer;
 		std::vector<std::string> textureName;
+		std::vector<std::vector<uint32_t>> lodIndexBuffer; ///< ڍדx1ȍ~̃CfbNX.
 	};
 
 	/**
@@ -204,6 +306,147 @@ namespace Mesh {
 		std::vector<TemporaryMaterial> materialList;
 	};
 
+	/**
+	* bV̉f[^狫EvZ.
+	*
+	* @param mesh bV̉f[^.
+	*
+	* @return S}eA̒_܂AABBƁAAABB̒S𒆐SƂ鋫E.
+	*/
+	Bounds CalcBounds(const TemporaryMesh& mesh){
+		Bounds bounds;
+		bool isFirst = true;
+		for (const TemporaryMaterial& material : mesh.materialList) {
+			for (const Vertex& v : material.vertexBuffer) {
+				if (isFirst) {
+					bounds.min = bounds.max = v.position;
+					isFirst = false;
+				}
+				bounds.min = glm::min(bounds.min, v.position);
+				bounds.max = glm::max(bounds.max, v.position);
+			}
+		}
+		// AABB̑Ίp̔菬Ȃ悤ɁAۂ̒_܂ł̍ő勗𔼌aɂ.
+		bounds.center = (bounds.min + bounds.max) * 0.5f;
+		float radiusSq = 0;
+		for (const TemporaryMaterial& material : mesh.materialList) {
+			for (const Vertex& v : material.vertexBuffer) {
+				const glm::vec3 d = v.position - bounds.center;
+				radiusSq = std::max(radiusSq, glm::dot(d, d));
+			}
+		}
+		bounds.radius = std::sqrt(radiusSq);
+		return bounds;
+	}
+
+	/**
+	* bV̉f[^̎Op`ƒ_AGPU悭ł鏇Ԃɕבւ.
+	*
+	* @param mesh bV̉f[^.
+	*
+	* _LbVōėp₷悤ɎOp`בւĂA
+	* _f[^ǂݍރAhXPɐiނ悤ɁA_ŏɎQƂ鏇Ԃɕבւ.
+	* ڍדxCfbNX͕בւ_̂ŁÅ֐ GenerateLods ɌĂԂ.
+	*/
+	void Optimize(TemporaryMesh& mesh){
+		for (TemporaryMaterial& material : mesh.materialList) {
+			material.indexBuffer = OptimizeVertexCache(material.indexBuffer, material.vertexBuffer.size());
+			const std::vector<uint32_t> remap = OptimizeVertexFetch(material.indexBuffer, material.vertexBuffer.size());
+			std::vector<Vertex> vertexBuffer(material.vertexBuffer.size());
+			for (size_t i = 0; i < remap.size(); ++i) {
+				vertexBuffer[remap[i]] = material.vertexBuffer[i];
+			}
+			material.vertexBuffer.swap(vertexBuffer);
+		}
+	}
+
+	/**
+	* CfbNXIBOɓ].
+	*
+	* @param offset  ]̃oCgItZbg.
+	* @param indices ]CfbNX.
+	* @param type    IBOɊi[^(GL_UNSIGNED_SHORT ܂ GL_UNSIGNED_INT).
+	*
+	* @return ]oCg.
+	*/
+	GLsizeiptr BufferIndexData(GLintptr offset, const std::vector<uint32_t>& indices, GLenum type){
+		if (type == GL_UNSIGNED_SHORT) {
+			const std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+			const GLsizeiptr bytes = shortIndices.size() * sizeof(uint16_t);
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, bytes, shortIndices.data());
+			return bytes;
+		}
+		const GLsizeiptr bytes = indices.size() * sizeof(uint32_t);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, bytes, indices.data());
+		return bytes;
+	}
+
+	/**
+	* CfbNX̓]ɕKvIBÕoCg߂.
+	*
+	* @param indexCount CfbNX̐.
+	* @param type       IBOɊi[^(GL_UNSIGNED_SHORT ܂ GL_UNSIGNED_INT).
+	*
+	* @return KvȃoCg. ̃f[^32rbgCfbNXłE悤ɁA4̔{ɐ؂グ.
+	*/
+	GLsizeiptr IndexDataSize(size_t indexCount, GLenum type){
+		const size_t bytes = indexCount * (type == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t));
+		return static_cast<GLsizeiptr>((bytes + 3) / 4 * 4);
+	}
+
+	/// ڍדx1i邲ƂɖڕWƂOp`̐̊.
+	const float lodReductionRatio = 0.5f;
+	/// Op`̐̊܂łȂ΁Aȏ̏ڍדx͍Ȃ.
+	const float minLodReduction = 0.8f;
+	/// Op`̐ȉɂȂAȏ̏ڍדx͍Ȃ.
+	const size_t minLodTriangleCount = 64;
+	/// ڍדxƂ́ÃbVɐ؂ւʏ̑傫(E̔a/ʂ̍̔).
+	const float lodScreenSize[maxLodCount] = { 1.0f, 0.2f, 0.1f, 0.05f };
+
+	/**
+	* bV̉f[^ɏڍדxCfbNXǉ.
+	*
+	* @param mesh bV̉f[^.
+	*
+	* @return 쐬ڍדx̐(̃bV܂܂Ȃ).
+	*
+	* 1̏ڍדx̃CfbNXӂ̏kŊȗ邱ƂJԂ.
+	* _f[^͌̂̂̂܂܎QƂ̂ŁAVBO̎gpʂ͑Ȃ.
+	*/
+	size_t GenerateLods(TemporaryMesh& mesh){
+		size_t triangleCount = 0;
+		for (const TemporaryMaterial& material : mesh.materialList) {
+			triangleCount += material.indexBuffer.size() / 3;
+		}
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec2> texCoords;
+		size_t level = 1;
+		for (; level < maxLodCount && triangleCount > minLodTriangleCount; ++level) {
+			size_t lodTriangleCount = 0;
+			for (TemporaryMaterial& material : mesh.materialList) {
+				positions.resize(material.vertexBuffer.size());
+				texCoords.resize(material.vertexBuffer.size());
+				for (size_t i = 0; i < material.vertexBuffer.size(); ++i) {
+					positions[i] = material.vertexBuffer[i].position;
+					texCoords[i] = material.vertexBuffer[i].texCoord;
+				}
+				const std::vector<uint32_t>& src = material.lodIndexBuffer.empty() ? material.indexBuffer : material.lodIndexBuffer.back();
+				const size_t target = static_cast<size_t>(static_cast<float>(src.size() / 3) * lodReductionRatio) * 3;
+				material.lodIndexBuffer.push_back(OptimizeVertexCache(
+					Simplify(positions, texCoords, src, target), material.vertexBuffer.size()));
+				lodTriangleCount += material.lodIndexBuffer.back().size() / 3;
+			}
+			if (static_cast<float>(lodTriangleCount) > static_cast<float>(triangleCount) * minLodReduction) {
+				for (TemporaryMaterial& material : mesh.materialList) {
+					material.lodIndexBuffer.pop_back();
+				}
+				break;
+			}
+			triangleCount = lodTriangleCount;
+		}
+		return level - 1;
+	}
+
 	/**
 	* FBXf[^𒆊ԃf[^ɕϊNX.
 	*/
@@ -379,6 +622,8 @@ namespace Mesh {
 			e.indexBuffer.reserve(avarageCapacity);
 			e.vertexBuffer.reserve(avarageCapacity);
 		}
+		// FBX̒_͊pƂɍ̂ŁASĂ̗vfv钸_}eAƂ1ɂ܂Ƃ߂.
+		std::vector<std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual>> vertexMapList(mesh.materialList.size());
 
 		// _ǂݎ.
 		const FbxAMatrix matTRS(fbxNode->EvaluateGlobalTransform());
@@ -445,9 +690,15 @@ namespace Mesh {
 				}
 
 				// _ɑΉ鉼}eAɁA_f[^ƃCfbNXf[^ǉ.
-				TemporaryMaterial& materialData = mesh.materialList[materialIndexList ? (*materialIndexList)[polygonIndex] : 0];
-				materialData.indexBuffer.push_back(static_cast<uint32_t>(materialData.vertexBuffer.size()));
-				materialData.vertexBuffer.push_back(v);
+				// _ǉς݂ȂACfbNXǉ.
+				const int materialIndex = materialIndexList ? (*materialIndexList)[polygonIndex] : 0;
+				TemporaryMaterial& materialData = mesh.materialList[materialIndex];
+				const auto itr = vertexMapList[materialIndex].insert(
+					std::make_pair(v, static_cast<uint32_t>(materialData.vertexBuffer.size()))).first;
+				if (itr->second == materialData.vertexBuffer.size()) {
+					materialData.vertexBuffer.push_back(v);
+				}
+				materialData.indexBuffer.push_back(itr->second);
 				++polygonVertex;
 			}
 		}
@@ -469,9 +720,11 @@ namespace Mesh {
 	/**
 	* bV`悷.
 	*
-	* @param buffer  `Ɏgpobt@IuWFNgւ̃|C^.
+	* @param buffer        `Ɏgpobt@IuWFNgւ̃|C^.
+	* @param instanceCount `悷CX^X̐.
+	*                      2ȏ̏ꍇ̓CX^X`s.
 	*/
-	void Mesh::Draw(const BufferPtr& buffer) const{
+	void Mesh::Draw(const BufferPtr& buffer, GLsizei instanceCount) const{
 		if (!buffer) {
 			return;
 		}
@@ -481,7 +734,11 @@ namespace Mesh {
 		}
 		for (size_t i = beginMaterial; i < endMaterial; ++i) {
 			const Material& m = buffer->GetMaterial(i);
-			glDrawElementsBaseVertex(GL_TRIANGLES, m.size, m.type, m.offset, m.baseVertex);
+			if (instanceCount > 1) {
+				glDrawElementsInstancedBaseVertex(GL_TRIANGLES, m.size, m.type, m.offset, instanceCount, m.baseVertex);
+			} else {
+				glDrawElementsBaseVertex(GL_TRIANGLES, m.size, m.type, m.offset, m.baseVertex);
+			}
 		}
 	}
 
@@ -490,11 +747,15 @@ namespace Mesh {
 	*
 	* @param vboSize  obt@Ɋi[\ȑ_.
 	* @param iboSize  obt@Ɋi[\ȑCfbNX.
+	* @param format   _f[^̌`.
+	*                 Packedw肷ƒ_f[^ȉɂȂA_VF[_ǂݍޗʂ点.
 	*/
-	BufferPtr Buffer::Create(int vboSize, int iboSize){
+	BufferPtr Buffer::Create(int vboSize, int iboSize, VertexFormat format){
 		struct Impl : Buffer { Impl() {} ~Impl() {} };
 		BufferPtr p = std::make_shared<Impl>();
-		p->vbo = CreateVBO(vboSize * sizeof(Vertex), nullptr);
+		p->vertexFormat = format;
+		p->vertexSize = format == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+		p->vbo = CreateVBO(vboSize * p->vertexSize, nullptr);
 		if (!p->vbo) {
 			return{};
 		}
@@ -502,7 +763,20 @@ namespace Mesh {
 		if (!p->ibo) {
 			return{};
 		}
-		p->vao = CreateVAO(p->vbo, p->ibo);
+		// Ԑڕ`ɂ͕`CfbNXŃf[^߂SSBObaseInstanceKv.
+		if (GLEW_VERSION_4_3 || (GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_base_instance)) {
+			p->supportedIndirectMode = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect ? IndirectMode::MultiDraw : IndirectMode::Loop;
+			std::vector<GLuint> drawIndexList(maxDrawIndexCount);
+			for (GLsizei i = 0; i < maxDrawIndexCount; ++i) {
+				drawIndexList[i] = i;
+			}
+			p->drawIndexBuffer = CreateVBO(drawIndexList.size() * sizeof(GLuint), drawIndexList.data());
+			if (!p->drawIndexBuffer) {
+				return{};
+			}
+		}
+		p->indirectMode = p->supportedIndirectMode;
+		p->vao = CreateVAO(p->vbo, p->ibo, p->drawIndexBuffer, format);
 		if (!p->vao) {
 			return{};
 		}
@@ -517,6 +791,9 @@ namespace Mesh {
 		if (vao) {
 			glDeleteVertexArrays(1, &vao);
 		}
+		if (drawIndexBuffer) {
+			glDeleteBuffers(1, &drawIndexBuffer);
+		}
 		if (ibo) {
 			glDeleteBuffers(1, &ibo);
 		}
@@ -532,6 +809,9 @@ namespace Mesh {
 	*
 	* @retval true  ǂݍݐ.
 	* @retval false ǂݍݎs.
+	*
+	* bVƂɁA_܂Ƃ߂O̒_VBÕoCgAבւOACMRo͂.
+	* Ԑڕ`ɑΉĂȂł́A_65536ȉ̃}eÃCfbNX16rbgŊi[.
 	*/
 	bool Buffer::LoadMeshFromFile(const char* filename){
 		FbxLoader loader;
@@ -544,34 +824,111 @@ namespace Mesh {
 		glGetBufferParameteri64v(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &vboSize);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
 		glGetBufferParameteri64v(GL_ELEMENT_ARRAY_BUFFER, GL_BUFFER_SIZE, &iboSize);
+		struct Impl : public Mesh {
+			Impl(const std::string& n, size_t b, size_t e) : Mesh(n, b, e) {}
+			~Impl() {}
+		};
+		std::vector<PackedVertex> packedVertexBuffer;
 		for (TemporaryMesh& e : loader.meshList) {
+			// FbxLoader _܂Ƃ߂O͊pƂɒ_̂ŁA_ƃLbV~X̓CfbNXɓ.
+			size_t cornerCount = 0;
+			size_t vertexCount = 0;
+			size_t weldedMissCount = 0;
+			for (const TemporaryMaterial& material : e.materialList) {
+				cornerCount += material.indexBuffer.size();
+				vertexCount += material.vertexBuffer.size();
+				weldedMissCount += CountVertexCacheMiss(material.indexBuffer);
+			}
+			Optimize(e);
+			size_t optimizedMissCount = 0;
+			for (const TemporaryMaterial& material : e.materialList) {
+				optimizedMissCount += CountVertexCacheMiss(material.indexBuffer);
+			}
+			if (cornerCount) {
+				const double faceCount = static_cast<double>(cornerCount / 3);
+				std::cout << "Mesh::Buffer::LoadMeshFromFile: " << e.name << ": _ " << cornerCount << " -> " << vertexCount <<
+					", VBO " << cornerCount * vertexSize << " -> " << vertexCount * vertexSize << "oCg, ACMR " <<
+					cornerCount / faceCount << " -> " << weldedMissCount / faceCount << "(_܂Ƃ߂) -> " <<
+					optimizedMissCount / faceCount << "(בւ)" << std::endl;
+			}
+
+			const size_t lodCount = GenerateLods(e);
+			std::vector<GLint> baseVertexList;
+			baseVertexList.reserve(e.materialList.size());
+			std::vector<GLenum> indexTypeList;
+			indexTypeList.reserve(e.materialList.size());
+			GLsizei triangleCount = 0;
 			for (TemporaryMaterial& material : e.materialList) {
-				const GLsizeiptr verticesBytes = material.vertexBuffer.size() * sizeof(Vertex);
+				const GLsizeiptr verticesBytes = material.vertexBuffer.size() * vertexSize;
 				if (vboEnd + verticesBytes >= vboSize) {
 					std::cerr << "WARNING: VBOTCYsĂ܂(" << vboEnd << '/' << vboSize << ')' << std::endl;
 					continue;
 				}
+				// Ԑڕ`̃R}h͑SẴ}eA𓯂^̃CfbNXƂĔŝŁA16rbgɂłȂ.
+				const GLenum indexType = supportedIndirectMode == IndirectMode::None &&
+					material.vertexBuffer.size() <= 0x10000 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 				const GLsizei indexSize = static_cast<GLsizei>(material.indexBuffer.size());
-				const GLsizeiptr indicesBytes = indexSize * sizeof(uint32_t);
+				const GLsizeiptr indicesBytes = IndexDataSize(indexSize, indexType);
 				if (iboEnd + indicesBytes >= iboSize) {
 					std::cerr << "WARNING: IBOTCYsĂ܂(" << iboEnd << '/' << iboSize << ')' << std::endl;
 					continue;
 				}
-				glBufferSubData(GL_ARRAY_BUFFER, vboEnd, verticesBytes, material.vertexBuffer.data());
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, iboEnd, indicesBytes, material.indexBuffer.data());
-				const GLint baseVertex = static_cast<uint32_t>(vboEnd / sizeof(Vertex));
-				materialList.push_back({ GL_UNSIGNED_INT, indexSize, reinterpret_cast<GLvoid*>(iboEnd), baseVertex, material.color });
+				if (vertexFormat == VertexFormat::Packed) {
+					packedVertexBuffer.resize(material.vertexBuffer.size());
+					std::transform(material.vertexBuffer.begin(), material.vertexBuffer.end(), packedVertexBuffer.begin(), Pack);
+					glBufferSubData(GL_ARRAY_BUFFER, vboEnd, verticesBytes, packedVertexBuffer.data());
+				} else {
+					glBufferSubData(GL_ARRAY_BUFFER, vboEnd, verticesBytes, material.vertexBuffer.data());
+				}
+				BufferIndexData(iboEnd, material.indexBuffer, indexType);
+				const GLint baseVertex = static_cast<uint32_t>(vboEnd / vertexSize);
+				materialList.push_back({ indexType, indexSize, reinterpret_cast<GLvoid*>(iboEnd), baseVertex, material.color });
+				baseVertexList.push_back(baseVertex);
+				indexTypeList.push_back(indexType);
+				triangleCount += indexSize / 3;
 				vboEnd += verticesBytes;
 				iboEnd += indicesBytes;
 			}
 
-			struct Impl : public Mesh {
-				Impl(const std::string& n, size_t b, size_t e) : Mesh(n, b, e) {}
-				~Impl() {}
-			};
 			const size_t endMaterial = materialList.size();
 			const size_t beginMaterial = endMaterial - e.materialList.size();
-			meshList.insert(std::make_pair(e.name, std::make_shared<Impl>(e.name, beginMaterial, endMaterial)));
+			MeshPtr mesh = std::make_shared<Impl>(e.name, beginMaterial, endMaterial);
+			mesh->bounds = CalcBounds(e);
+			mesh->triangleCount = triangleCount;
+			meshList.insert(std::make_pair(e.name, mesh));
+
+			// ڍדxCfbNX́Ã}eAƓ_f[^QƂ}eAƂĒǉ.
+			if (baseVertexList.size() != e.materialList.size()) {
+				continue;
+			}
+			for (size_t level = 1; level <= lodCount; ++level) {
+				GLsizeiptr indicesBytes = 0;
+				for (size_t i = 0; i < e.materialList.size(); ++i) {
+					indicesBytes += IndexDataSize(e.materialList[i].lodIndexBuffer[level - 1].size(), indexTypeList[i]);
+				}
+				if (iboEnd + indicesBytes >= iboSize) {
+					std::cerr << "WARNING: IBOTCYsĂ邽'" << e.name << "'̏ڍדx" << level <<
+						"ȍ~쐬ł܂(" << iboEnd << '/' << iboSize << ')' << std::endl;
+					break;
+				}
+				const size_t lodBeginMaterial = materialList.size();
+				GLsizei lodTriangleCount = 0;
+				for (size_t i = 0; i < e.materialList.size(); ++i) {
+					const TemporaryMaterial& material = e.materialList[i];
+					const std::vector<uint32_t>& indices = material.lodIndexBuffer[level - 1];
+					const GLsizei indexSize = static_cast<GLsizei>(indices.size());
+					BufferIndexData(iboEnd, indices, indexTypeList[i]);
+					materialList.push_back({ indexTypeList[i], indexSize, reinterpret_cast<GLvoid*>(iboEnd), baseVertexList[i], material.color });
+					lodTriangleCount += indexSize / 3;
+					iboEnd += IndexDataSize(indexSize, indexTypeList[i]);
+				}
+				const std::string lodName = e.name + ".LOD" + std::to_string(level);
+				MeshPtr lodMesh = std::make_shared<Impl>(lodName, lodBeginMaterial, materialList.size());
+				lodMesh->bounds = mesh->bounds;
+				lodMesh->triangleCount = lodTriangleCount;
+				meshList.insert(std::make_pair(lodName, lodMesh));
+				mesh->lodList.push_back({ lodMesh, lodScreenSize[level] });
+			}
 		}
 		return true;
 	}
@@ -611,7 +968,45 @@ namespace Mesh {
 	* obt@ێVAOOpenGL̏Ώۂɐݒ肷.
 	*/
 	void Buffer::BindVAO() const{
-		glBindVertexArray(vao);
+		GLState::BindVertexArray(vao);
+	}
+
+	/**
+	* Ԑڕ`R}h̔s@ݒ肷.
+	*
+	* @param mode s@.
+	*             ΉĂȂ@w肳ꂽꍇ́AΉĂ͈͂ōł߂@ɂȂ.
+	*/
+	void Buffer::SetIndirectMode(IndirectMode mode){
+		indirectMode = std::min(mode, supportedIndirectMode);
+	}
+
+	/**
+	* Ԑڕ`R}h𔭍s.
+	*
+	* @param commandBuffer commandsƓei[obt@IuWFNg.
+	* @param commands      Ԑڕ`R}h̔z.
+	* @param first         sŏ̃R}h̃CfbNX.
+	* @param count         sR}h̐.
+	*
+	* glMultiDrawElementsIndirect gȂł́Acommands̓eCPU1s.
+	*/
+	void Buffer::DrawIndirect(GLuint commandBuffer, const DrawElementsIndirectCommand* commands, GLsizei first, GLsizei count) const{
+		switch (indirectMode) {
+		case IndirectMode::MultiDraw:
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+				reinterpret_cast<const GLvoid*>(first * sizeof(DrawElementsIndirectCommand)), count, 0);
+			break;
+		case IndirectMode::Loop:
+			for (const DrawElementsIndirectCommand* p = commands + first; p != commands + first + count; ++p) {
+				glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, p->count, GL_UNSIGNED_INT,
+					reinterpret_cast<const GLvoid*>(p->firstIndex * sizeof(uint32_t)), p->instanceCount, p->baseVertex, p->baseInstance);
+			}
+			break;
+		default:
+			break;
+		}
 	}
 
 } // namespace Mesh
\ No newline at end of file
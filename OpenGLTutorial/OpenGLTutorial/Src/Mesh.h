@@ -28,6 +28,53 @@ namespace Mesh {
 		glm::vec4 color; ///< }eA̐F.
 	};
 
+	/**
+	* bV̋E([JWn).
+	*/
+	struct Bounds{
+		glm::vec3 min = glm::vec3(0); ///< AABB̍ŏW.
+		glm::vec3 max = glm::vec3(0); ///< AABB̍őW.
+		glm::vec3 center = glm::vec3(0); ///< E̒S.
+		float radius = 0; ///< E̔a.
+	};
+
+	/**
+	* Ԑڕ`R}h.
+	*
+	* o̕т glDrawElementsIndirect v`Ɠ.
+	*/
+	struct DrawElementsIndirectCommand{
+		GLuint count; ///< `悷CfbNX.
+		GLuint instanceCount; ///< `悷CX^X̐.
+		GLuint firstIndex; ///< `JnCfbNX.
+		GLint baseVertex; ///< CfbNX0Ƃ݂Ȃ钸_z̈ʒu.
+		GLuint baseInstance; ///< `CfbNX̊Jnl.
+	};
+
+	/**
+	* Ԑڕ`R}h̔s@.
+	*/
+	enum class IndirectMode{
+		None, ///< Ԑڕ`gȂ.
+		Loop, ///< R}h1CPU甭s.
+		MultiDraw, ///< glMultiDrawElementsIndirect ł܂Ƃ߂Ĕs.
+	};
+
+	/**
+	* _f[^̌`.
+	*/
+	enum class VertexFormat{
+		Float, ///< SĂ̗vf32rbg_Ŋi[(64oCg).
+		Packed, ///< WȊO̗vfkĊi[(28oCg).
+	};
+
+	/// `CfbNX󂯎钸_Agr[g̃CfbNX.
+	static const GLuint drawIndexAttribute = 5;
+	/// `CfbNX̍ő吔.
+	static const GLsizei maxDrawIndexCount = 64 * 1024;
+	/// 1̃bVڍדx(LOD)̍ő吔. ̃bV܂.
+	static const size_t maxLodCount = 4;
+
 	/**
 	* bVf[^.
 	*/
@@ -35,7 +82,30 @@ namespace Mesh {
 		friend class Buffer;
 	public:
 		const std::string& Name() const { return name; }
-		void Draw(const BufferPtr& buffer) const;
+		size_t BeginMaterial() const { return beginMaterial; }
+		size_t EndMaterial() const { return endMaterial; }
+		const Bounds& GetBounds() const { return bounds; }
+		GLsizei TriangleCount() const { return triangleCount; }
+		size_t LodCount() const { return lodList.size() + 1; }
+		void Draw(const BufferPtr& buffer, GLsizei instanceCount = 1) const;
+
+		/**
+		* ʏ̑傫ɍڍדx̃bVI.
+		*
+		* @param screenSize E̔aʂ̍̔1Ƃĕ\傫.
+		*
+		* @return `ɎgbV. ڍדxKvȂthis.
+		*/
+		const Mesh* SelectLod(float screenSize) const {
+			const Mesh* result = this;
+			for (const Lod& lod : lodList) {
+				if (screenSize >= lod.screenSize) {
+					break;
+				}
+				result = lod.mesh.get();
+			}
+			return result;
+		}
 
 	private:
 		Mesh() = default;
@@ -49,6 +119,15 @@ namespace Mesh {
 		std::vector<std::string> textureList; ///< eNX`̃Xg.
 		size_t beginMaterial = 0; ///< `悷}eA̐擪CfbNX.
 		size_t endMaterial = 0; ///< `悷}eȀI[CfbNX.
+		Bounds bounds; ///< E.
+		GLsizei triangleCount = 0; ///< S}eA̎Op`̐.
+
+		/// ڍדxbV.
+		struct Lod {
+			MeshPtr mesh; ///< _f[^̃bVƋLACfbNX炵bV.
+			float screenSize; ///< ʏ̑傫菬ȂÃbVg.
+		};
+		std::vector<Lod> lodList; ///< ڍדx̍ɕׂXg.
 	};
 
 	/**
@@ -56,12 +135,15 @@ namespace Mesh {
 	*/
 	class Buffer{
 	public:
-		static BufferPtr Create(int vboSize, int iboSize);
+		static BufferPtr Create(int vboSize, int iboSize, VertexFormat format = VertexFormat::Float);
 
 		bool LoadMeshFromFile(const char* filename);
 		const MeshPtr& GetMesh(const char* name) const;
 		const Material& GetMaterial(size_t index) const;
 		void BindVAO() const;
+		IndirectMode GetIndirectMode() const { return indirectMode; }
+		void SetIndirectMode(IndirectMode mode);
+		void DrawIndirect(GLuint commandBuffer, const DrawElementsIndirectCommand* commands, GLsizei first, GLsizei count) const;
 
 	private:
 		Buffer() = default;
@@ -73,6 +155,11 @@ namespace Mesh {
 		GLuint vbo = 0; ///< f̒_f[^i[VBO.
 		GLuint ibo = 0; ///< f̃CfbNXf[^i[IBO.
 		GLuint vao = 0; ///< fpVAO.
+		GLuint drawIndexBuffer = 0; ///< `CfbNXi[VBO.
+		VertexFormat vertexFormat = VertexFormat::Float; ///< _f[^̌`.
+		GLsizei vertexSize = 0; ///< 1_̃oCg.
+		IndirectMode supportedIndirectMode = IndirectMode::None; ///< ΉĂԐڕ`̕@.
+		IndirectMode indirectMode = IndirectMode::None; ///< Ԑڕ`̕@.
 		GLintptr vboEnd = 0; ///< ǂݍݍςݒ_f[^̏I[.
 		GLintptr iboEnd = 0; ///< ǂݍݍς݃CfbNXf[^̏I[.
 
@@ -0,0 +1,177 @@
+/**
+* @file MeshOptimize.cpp
+*/
+#include "MeshOptimize.h"
+#include <algorithm>
+#include <deque>
+
+namespace Mesh {
+
+	namespace /* unnamed */ {
+
+		/// _QƂĂȂƂl.
+		const uint32_t invalidIndex = 0xffffffff;
+
+		/**
+		* _A̒_gOp`߂̗אڃXg.
+		*/
+		struct Adjacency {
+			std::vector<uint32_t> offset; ///< _Ƃ́Atriangle̐擪ʒu(_+1).
+			std::vector<uint32_t> triangle; ///< _gOp`̔ԍ.
+
+			Adjacency(const std::vector<uint32_t>& indices, size_t vertexCount) :
+				offset(vertexCount + 1, 0), triangle(indices.size()) {
+				for (uint32_t i : indices) {
+					++offset[i + 1];
+				}
+				for (size_t i = 0; i < vertexCount; ++i) {
+					offset[i + 1] += offset[i];
+				}
+				std::vector<uint32_t> cursor(offset.begin(), offset.end() - 1);
+				for (size_t i = 0; i < indices.size(); ++i) {
+					triangle[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+				}
+			}
+		};
+
+	} // unnamed namespace
+
+	/**
+	* _LbVōėp₷悤ɎOp`בւ.
+	*
+	* @param indices     Op`Xg̃CfbNXz.
+	* @param vertexCount CfbNXQƂ钸_̐.
+	* @param cacheSize   z肷钸_LbV̑傫.
+	*
+	* @return בւCfbNXz. Op`̒_̏(\)͕ςȂ.
+	*
+	* Tipsify(Sander, Nehab, Barczak 2007)ɂ.
+	* 1̒_𒆐SɁA̒_gOp`Sďo͂邱ƂJԂ.
+	* ̒Sɂ́Ao͂Op`̒_̂Ac̎Op`o͂ĂLbVɎcĂ
+	* ƂÂ_I. ₪Ȃ΁Aŋߏo͂_ACfbNX̒_̏ɒT.
+	*/
+	std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize){
+		const size_t triangleCount = indices.size() / 3;
+		const Adjacency adjacency(indices, vertexCount);
+		std::vector<uint32_t> liveCount(vertexCount);
+		for (size_t i = 0; i < vertexCount; ++i) {
+			liveCount[i] = adjacency.offset[i + 1] - adjacency.offset[i];
+		}
+		std::vector<size_t> cacheTime(vertexCount, 0); // _LbVɓ.
+		std::vector<bool> isEmitted(triangleCount, false);
+		std::vector<uint32_t> deadEnd; // o͂_̃X^bN.
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> result;
+		result.reserve(triangleCount * 3);
+
+		size_t time = cacheSize + 1;
+		size_t cursor = 0;
+		uint32_t fanning = vertexCount ? 0 : invalidIndex;
+		while (fanning != invalidIndex) {
+			// S̒_gOp`Sďo͂.
+			candidates.clear();
+			for (uint32_t i = adjacency.offset[fanning]; i < adjacency.offset[fanning + 1]; ++i) {
+				const uint32_t t = adjacency.triangle[i];
+				if (isEmitted[t]) {
+					continue;
+				}
+				isEmitted[t] = true;
+				for (int n = 0; n < 3; ++n) {
+					const uint32_t v = indices[t * 3 + n];
+					result.push_back(v);
+					deadEnd.push_back(v);
+					candidates.push_back(v);
+					--liveCount[v];
+					if (time - cacheTime[v] > cacheSize) {
+						cacheTime[v] = time++;
+					}
+				}
+			}
+
+			// o͂_玟̒SI.
+			fanning = invalidIndex;
+			size_t bestPriority = 0;
+			for (uint32_t v : candidates) {
+				if (!liveCount[v]) {
+					continue;
+				}
+				// c̎Op`o͂ĂLbVɎcĂ钸_́AÂقǗD悷.
+				size_t priority = 1;
+				if (time - cacheTime[v] + 2 * liveCount[v] <= cacheSize) {
+					priority = time - cacheTime[v] + 1;
+				}
+				if (priority > bestPriority) {
+					bestPriority = priority;
+					fanning = v;
+				}
+			}
+			while (fanning == invalidIndex && !deadEnd.empty()) {
+				const uint32_t v = deadEnd.back();
+				deadEnd.pop_back();
+				if (liveCount[v]) {
+					fanning = v;
+				}
+			}
+			for (; fanning == invalidIndex && cursor < vertexCount; ++cursor) {
+				if (liveCount[cursor]) {
+					fanning = static_cast<uint32_t>(cursor);
+				}
+			}
+		}
+		return result;
+	}
+
+	/**
+	* _ŏɎQƂ鏇Ԃɕבւ邽߂̑Ή\쐬.
+	*
+	* @param indices     Op`Xg̃CfbNXz. בւ̒_QƂ悤ɏ.
+	* @param vertexCount CfbNXQƂ钸_̐.
+	*
+	* @return ̒_ԍAבւ̒_ԍΉ\.
+	*         QƂȂ_́AQƂ钸_̌Ɍ̏Ԃŕ.
+	*
+	* _VF[_ǂݍޒ_f[^̃AhXPɐiނ悤ɂȂA̓ǂݍ݂悭Ȃ.
+	* _LbV̂߂̎Op`̕בւsɎg.
+	*/
+	std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount){
+		std::vector<uint32_t> remap(vertexCount, invalidIndex);
+		uint32_t next = 0;
+		for (uint32_t& i : indices) {
+			if (remap[i] == invalidIndex) {
+				remap[i] = next++;
+			}
+			i = remap[i];
+		}
+		for (uint32_t& e : remap) {
+			if (e == invalidIndex) {
+				e = next++;
+			}
+		}
+		return remap;
+	}
+
+	/**
+	* _LbV(FIFO)ōėpłȂ_̐𐔂.
+	*
+	* @param indices   Op`Xg̃CfbNXz.
+	* @param cacheSize z肷钸_LbV̑傫.
+	*
+	* @return _VF[_s. Op`̐ŊACMR(Average Cache Miss Ratio)ɂȂ.
+	*/
+	size_t CountVertexCacheMiss(const std::vector<uint32_t>& indices, size_t cacheSize){
+		std::deque<uint32_t> cache;
+		size_t missCount = 0;
+		for (uint32_t i : indices) {
+			if (std::find(cache.begin(), cache.end(), i) != cache.end()) {
+				continue;
+			}
+			++missCount;
+			cache.push_back(i);
+			if (cache.size() > cacheSize) {
+				cache.pop_front();
+			}
+		}
+		return missCount;
+	}
+
+} // namespace Mesh
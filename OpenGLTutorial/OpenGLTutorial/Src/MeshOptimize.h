@@ -0,0 +1,22 @@
+/**
+* @file MeshOptimize.h
+*/
+#ifndef MESHOPTIMIZE_H_INCLUDED
+#define MESHOPTIMIZE_H_INCLUDED
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Mesh {
+
+	/// בւőz肷钸_LbV(FIFO)̑傫.
+	static const size_t vertexCacheSize = 16;
+
+	std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+		size_t cacheSize = vertexCacheSize);
+	std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount);
+	size_t CountVertexCacheMiss(const std::vector<uint32_t>& indices, size_t cacheSize = vertexCacheSize);
+
+} // namespace Mesh
+
+#endif // MESHOPTIMIZE_H_INCLUDED
@@ -0,0 +1,302 @@
+/**
+* @file MeshSimplify.cpp
+*/
+#include "MeshSimplify.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <cmath>
+#include <string.h>
+
+namespace Mesh {
+
+	namespace /* unnamed */ {
+
+		/// E̕ӂɉ镽ʂ̏d. 傫قǗ֊sۂ.
+		const double boundaryWeight = 100.0;
+		/// ʂ̖@̒lȉ܂ŌXḱAʂԂƂ݂ȂčsȂ.
+		const float minNormalDot = 0.2f;
+
+		/**
+		* 񎟌덷s(Ώ4x4s̏Op).
+		*/
+		struct Quadric {
+			double m[10] = {};
+
+			/**
+			* ʂ܂ł̋2덷Ƃs.
+			*
+			* @param n      ʂ̒Pʖ@.
+			* @param d      ʂ̒萔(-dot(n, ʏ̓_)).
+			* @param weight d.
+			*/
+			void AddPlane(const glm::vec3& n, float d, double weight) {
+				const double p[4] = { n.x, n.y, n.z, d };
+				int k = 0;
+				for (int i = 0; i < 4; ++i) {
+					for (int j = i; j < 4; ++j) {
+						m[k++] += p[i] * p[j] * weight;
+					}
+				}
+			}
+
+			Quadric& operator+=(const Quadric& q) {
+				for (int i = 0; i < 10; ++i) {
+					m[i] += q.m[i];
+				}
+				return *this;
+			}
+
+			/**
+			* _̌덷߂.
+			*
+			* @param v _̍W.
+			*
+			* @return ʂ܂ł̋2̏dݕta.
+			*/
+			double Error(const glm::vec3& v) const {
+				const double x = v.x, y = v.y, z = v.z;
+				return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x +
+					m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y +
+					m[7] * z * z + 2 * m[8] * z + m[9];
+			}
+		};
+
+		/// WrbgPʂŔr邽߂̃nbV.
+		struct PositionHash {
+			size_t operator()(const glm::vec3& v) const {
+				uint32_t bits[3];
+				memcpy(bits, &v.x, sizeof(bits));
+				return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+			}
+		};
+
+		/// ǩƂȂ.
+		struct Edge {
+			uint32_t from; ///< 菜_.
+			uint32_t to; ///< c_.
+			double cost; ///< kɂ덷.
+		};
+
+		/**
+		* Op`̖@(KȂ)߂.
+		*/
+		glm::vec3 FaceNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2){
+			return glm::cross(p1 - p0, p2 - p0);
+		}
+
+	} // unnamed namespace
+
+	/**
+	* ӂ̏kJԂāAOp`̐炵CfbNXz쐬.
+	*
+	* @param positions        _̍W.
+	* @param texCoords        _̃eNX`W(positionsƓvf).
+	* @param indices          Op`Xg̃CfbNXz.
+	* @param targetIndexCount ڕWƂCfbNX. `ۂĂȂꍇ͂葽Ȃ.
+	*
+	* @return ȗCfbNXz. QƂ钸_positionŝ̂ŁAV_͍Ȃ.
+	*
+	* W_1ɂ܂Ƃ߂ʑ̏ŁA񎟌덷ŏɂȂӂ珇ɁA
+	* ̒_̒_̈ʒuɈڂk(n[tGbWk)s.
+	* _ړȂ̂ŁAȗʂ͌̒_ẑ܂܎QƂł.
+	* kŏ_QƂĂpɂ́Acʒuɂ钸_̂A
+	* ̒_ƃeNX`Wł߂̂蓖Ă.
+	*/
+	std::vector<uint32_t> Simplify(const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& texCoords,
+		const std::vector<uint32_t>& indices, size_t targetIndexCount){
+
+		// W̒_ŏɌꂽ_ɂ܂Ƃ߂.
+		std::vector<uint32_t> remap(positions.size());
+		std::vector<std::vector<uint32_t>> wedgeList(positions.size());
+		std::unordered_map<glm::vec3, uint32_t, PositionHash> positionMap;
+		for (uint32_t i = 0; i < positions.size(); ++i) {
+			const auto result = positionMap.insert(std::make_pair(positions[i], i));
+			remap[i] = result.first->second;
+			wedgeList[remap[i]].push_back(i);
+		}
+
+		const size_t triangleCount = indices.size() / 3;
+		std::vector<uint32_t> triangleList(triangleCount * 3);
+		for (size_t i = 0; i < triangleCount * 3; ++i) {
+			triangleList[i] = remap[indices[i]];
+		}
+		std::vector<char> isRemoved(triangleCount, 0);
+		size_t liveCount = triangleCount;
+
+		// _ƂɁA̖ʂ̕ʂƋE̕ӂɐȕʂ̓񎟌덷W߂.
+		std::vector<Quadric> quadricList(positions.size());
+		std::vector<std::vector<uint32_t>> adjacencyList(positions.size());
+		std::unordered_map<uint64_t, int> edgeCount;
+		const auto edgeKey = [](uint32_t a, uint32_t b) {
+			const auto e = std::minmax(a, b);
+			return (static_cast<uint64_t>(e.first) << 32) | e.second;
+		};
+		for (size_t t = 0; t < triangleCount; ++t) {
+			const uint32_t* v = &triangleList[t * 3];
+			if (v[0] == v[1] || v[1] == v[2] || v[2] == v[0]) {
+				isRemoved[t] = 1;
+				--liveCount;
+				continue;
+			}
+			const glm::vec3 n = FaceNormal(positions[v[0]], positions[v[1]], positions[v[2]]);
+			const float area2 = glm::length(n);
+			if (area2 > 0) {
+				const glm::vec3 unitNormal = n / area2;
+				Quadric q;
+				q.AddPlane(unitNormal, -glm::dot(unitNormal, positions[v[0]]), area2 * 0.5);
+				for (int k = 0; k < 3; ++k) {
+					quadricList[v[k]] += q;
+				}
+			}
+			for (int k = 0; k < 3; ++k) {
+				adjacencyList[v[k]].push_back(static_cast<uint32_t>(t));
+				++edgeCount[edgeKey(v[k], v[(k + 1) % 3])];
+			}
+		}
+		for (size_t t = 0; t < triangleCount; ++t) {
+			if (isRemoved[t]) {
+				continue;
+			}
+			const uint32_t* v = &triangleList[t * 3];
+			const glm::vec3 n = FaceNormal(positions[v[0]], positions[v[1]], positions[v[2]]);
+			for (int k = 0; k < 3; ++k) {
+				const uint32_t a = v[k];
+				const uint32_t b = v[(k + 1) % 3];
+				if (edgeCount[edgeKey(a, b)] != 1) {
+					continue;
+				}
+				const glm::vec3 edge = positions[b] - positions[a];
+				const glm::vec3 side = glm::cross(edge, n);
+				const float length = glm::length(side);
+				if (length > 0) {
+					const glm::vec3 unitSide = side / length;
+					Quadric q;
+					q.AddPlane(unitSide, -glm::dot(unitSide, positions[a]), glm::dot(edge, edge) * boundaryWeight);
+					quadricList[a] += q;
+					quadricList[b] += q;
+				}
+			}
+		}
+
+		// k񂵂Ă̖ʂԂȂׂ.
+		const auto canCollapse = [&](uint32_t from, uint32_t to) {
+			for (uint32_t t : adjacencyList[from]) {
+				if (isRemoved[t]) {
+					continue;
+				}
+				const uint32_t* v = &triangleList[t * 3];
+				if (v[0] == to || v[1] == to || v[2] == to) {
+					continue;
+				}
+				glm::vec3 p[3] = { positions[v[0]], positions[v[1]], positions[v[2]] };
+				const glm::vec3 before = FaceNormal(p[0], p[1], p[2]);
+				for (int k = 0; k < 3; ++k) {
+					if (v[k] == from) {
+						p[k] = positions[to];
+					}
+				}
+				const glm::vec3 after = FaceNormal(p[0], p[1], p[2]);
+				const float lengthSq = glm::dot(before, before) * glm::dot(after, after);
+				if (lengthSq <= 0 || glm::dot(before, after) <= minNormalDot * std::sqrt(lengthSq)) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		// 덷̏ӂA_dȂȂ͈͂ł܂Ƃ߂ďk񂷂邱ƂJԂ.
+		std::vector<Edge> edgeList;
+		std::unordered_set<uint64_t> edgeSet;
+		std::vector<char> isLocked(positions.size());
+		const size_t targetTriangleCount = targetIndexCount / 3;
+		while (liveCount > targetTriangleCount) {
+			edgeList.clear();
+			edgeSet.clear();
+			for (size_t t = 0; t < triangleCount; ++t) {
+				if (isRemoved[t]) {
+					continue;
+				}
+				const uint32_t* v = &triangleList[t * 3];
+				for (int k = 0; k < 3; ++k) {
+					const uint32_t a = v[k];
+					const uint32_t b = v[(k + 1) % 3];
+					if (!edgeSet.insert(edgeKey(a, b)).second) {
+						continue; // ׂ̖ʂƋLӂ1xɂ. E̕ӂ͌ɂ炸ɂȂ.
+					}
+					Quadric q = quadricList[a];
+					q += quadricList[b];
+					const double costAB = q.Error(positions[b]);
+					const double costBA = q.Error(positions[a]);
+					edgeList.push_back(costAB <= costBA ? Edge{ a, b, costAB } : Edge{ b, a, costBA });
+				}
+			}
+			std::sort(edgeList.begin(), edgeList.end(), [](const Edge& lhs, const Edge& rhs) { return lhs.cost < rhs.cost; });
+
+			std::fill(isLocked.begin(), isLocked.end(), 0);
+			size_t collapseCount = 0;
+			for (const Edge& e : edgeList) {
+				if (liveCount <= targetTriangleCount) {
+					break;
+				}
+				if (isLocked[e.from] || isLocked[e.to] || !canCollapse(e.from, e.to)) {
+					continue;
+				}
+				for (uint32_t t : adjacencyList[e.from]) {
+					if (isRemoved[t]) {
+						continue;
+					}
+					uint32_t* v = &triangleList[t * 3];
+					if (v[0] == e.to || v[1] == e.to || v[2] == e.to) {
+						isRemoved[t] = 1;
+						--liveCount;
+						continue;
+					}
+					for (int k = 0; k < 3; ++k) {
+						if (v[k] == e.from) {
+							v[k] = e.to;
+						}
+					}
+					adjacencyList[e.to].push_back(t);
+				}
+				adjacencyList[e.from].clear();
+				quadricList[e.to] += quadricList[e.from];
+				isLocked[e.from] = isLocked[e.to] = 1;
+				++collapseCount;
+			}
+			if (collapseCount == 0) {
+				break; // ȏ͌`󂳂ɏkłȂ.
+			}
+		}
+
+		// cʂ̊pɌ̒_蓖Ă.
+		std::vector<uint32_t> result;
+		result.reserve(liveCount * 3);
+		for (size_t t = 0; t < triangleCount; ++t) {
+			if (isRemoved[t]) {
+				continue;
+			}
+			for (int k = 0; k < 3; ++k) {
+				const uint32_t original = indices[t * 3 + k];
+				const uint32_t current = triangleList[t * 3 + k];
+				if (remap[original] == current) {
+					result.push_back(original);
+					continue;
+				}
+				uint32_t best = current;
+				float bestDistance = -1;
+				for (uint32_t w : wedgeList[current]) {
+					const glm::vec2 d = texCoords[w] - texCoords[original];
+					const float distance = glm::dot(d, d);
+					if (bestDistance < 0 || distance < bestDistance) {
+						best = w;
+						bestDistance = distance;
+					}
+				}
+				result.push_back(best);
+			}
+		}
+		return result;
+	}
+
+} // namespace Mesh
@@ -0,0 +1,17 @@
+/**
+* @file MeshSimplify.h
+*/
+#ifndef MESHSIMPLIFY_H_INCLUDED
+#define MESHSIMPLIFY_H_INCLUDED
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+namespace Mesh {
+
+	std::vector<uint32_t> Simplify(const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& texCoords,
+		const std::vector<uint32_t>& indices, size_t targetIndexCount);
+
+} // namespace Mesh
+
+#endif // MESHSIMPLIFY_H_INCLUDED
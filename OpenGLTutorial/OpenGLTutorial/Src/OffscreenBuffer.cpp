@@ -2,6 +2,7 @@
 * @file OffscreenBuffer.cpp
 */
 #include "OffscreenBuffer.h"
+#include "GLState.h"
 
 /**
 * ItXN[obt@쐬.
@@ -33,10 +34,10 @@ OffscreenBufferPtr OffscreenBuffer::Create(int w, int h){
 
 	// t[obt@Ƃē
 	glGenFramebuffers(1, &offscreen->framebuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, offscreen->framebuffer);
+	GLState::BindFramebuffer(offscreen->framebuffer);
 	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, offscreen->depthbuffer);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, offscreen->tex->Id(), 0);
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLState::BindFramebuffer(0);
 
 	return offscreen;
 }
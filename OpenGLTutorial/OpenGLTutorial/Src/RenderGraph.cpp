@@ -0,0 +1,304 @@
+/**
+* @file RenderGraph.cpp
+*/
+#include "RenderGraph.h"
+#include "GLState.h"
+#include <algorithm>
+#include <iostream>
+
+namespace RenderGraph {
+
+	/**
+	* _[Ot쐬.
+	*
+	* @param width        obNobt@̕.
+	* @param height       obNobt@̍.
+	* @param createEffect |XgGtFNg̃}NVF[_쐬֐.
+	* @param drawEffect   |XgGtFNg̃VF[_őSʂ`悷֐.
+	*
+	* @return 쐬_[Otւ̃|C^.
+	*/
+	GraphPtr Graph::Create(int width, int height, const CreateEffectFunc& createEffect, const DrawEffectFunc& drawEffect){
+		struct Impl : Graph { Impl() {} ~Impl() {} };
+		GraphPtr p = std::make_shared<Impl>();
+		p->width = width;
+		p->height = height;
+		p->createEffect = createEffect;
+		p->drawEffect = drawEffect;
+		p->Clear();
+		return p;
+	}
+
+	/**
+	* 錾pXƃ\[XSč폜.
+	*
+	* 蓖čς݂̃ItXN[obt@́ACompileōėp邽߂ɎcĂ.
+	*/
+	void Graph::Clear(){
+		resourceList.clear();
+		resourceList.push_back({ "Backbuffer", width, height, width, height, -1, -1, -1 });
+		passList.clear();
+		compiledList.clear();
+		stats = Stats();
+	}
+
+	/**
+	* `Ɏg\[X錾.
+	*
+	* @param name   \[X(fobOp).
+	* @param width  .
+	* @param height .
+	*
+	* @return 錾\[X̎ʔԍ.
+	*
+	* ItXN[obt@CompileŊ蓖Ă.
+	*/
+	ResourceId Graph::CreateTarget(const char* name, int width, int height){
+		resourceList.push_back({ name, width, height, width, height, -1, -1, -1 });
+		return static_cast<ResourceId>(resourceList.size() - 1);
+	}
+
+	/**
+	* \[X̕`͈͂ݒ肷.
+	*
+	* @param id     \[X̎ʔԍ.
+	* @param width  `͈͂̕.
+	* @param height `͈͂̍.
+	*
+	* `͈͂̓\[X̍_ƂA\[X̑傫𒴂Ȃ.
+	* ItXN[obt@蒼ɉ𑜓xς邽߂Ɏg.
+	* CompilěłݒłAExecute甽f.
+	*/
+	void Graph::Viewport(ResourceId id, int width, int height){
+		if (id < 0 || id >= static_cast<ResourceId>(resourceList.size())) {
+			return;
+		}
+		Resource& e = resourceList[id];
+		e.viewportWidth = std::min(std::max(width, 1), e.width);
+		e.viewportHeight = std::min(std::max(height, 1), e.height);
+	}
+
+	/**
+	* `pX錾.
+	*
+	* @param name   pX(fobOp).
+	* @param inputs ǂݍރ\[X̃Xg.
+	* @param output ރ\[X.
+	* @param func   `֐.
+	*
+	* pX͐錾ɕ`悳.
+	*/
+	void Graph::AddPass(const char* name, const std::vector<ResourceId>& inputs, ResourceId output, const ExecuteFunc& func){
+		Pass pass;
+		pass.name = name;
+		pass.inputs = inputs;
+		pass.output = output;
+		pass.func = func;
+		pass.isEffect = false;
+		pass.firstOrder = pass.lastOrder = 0;
+		passList.push_back(pass);
+	}
+
+	/**
+	* Sʃ|XgGtFNg̃pX錾.
+	*
+	* @param name   pX(fobOp).
+	* @param input  ǂݍރ\[X.
+	* @param output ރ\[X.
+	* @param define ʂLɂ}N. nullptrȂ͂̂܂܏.
+	* @param order  VF[_ł̌ʂ̓Kp.
+	*
+	* ÕpX̌ʂǂݍ݁AÕpXKpȂ΁A
+	* CompileŒÕpXɂ܂Ƃ߂.
+	*/
+	void Graph::AddEffectPass(const char* name, ResourceId input, ResourceId output, const char* define, int order){
+		Pass pass;
+		pass.name = name;
+		pass.inputs.push_back(input);
+		pass.output = output;
+		pass.isEffect = true;
+		if (define) {
+			pass.defines.push_back(define);
+		}
+		pass.firstOrder = pass.lastOrder = order;
+		passList.push_back(pass);
+	}
+
+	/**
+	* 錾pX`悷pX̃Xg쐬.
+	*
+	* @retval true  쐬.
+	* @retval false 쐬s.
+	*/
+	bool Graph::Compile(){
+		compiledList.clear();
+		stats = Stats();
+		stats.passCount = passList.size();
+
+		// ̃pXAobNobt@ɓ͂pXc.
+		std::vector<bool> isNeeded(resourceList.size(), false);
+		isNeeded[backbuffer] = true;
+		std::vector<bool> isAlive(passList.size(), false);
+		for (size_t i = passList.size(); i > 0; --i) {
+			const Pass& pass = passList[i - 1];
+			if (!isNeeded[pass.output]) {
+				++stats.culledCount;
+				continue;
+			}
+			isAlive[i - 1] = true;
+			for (ResourceId id : pass.inputs) {
+				isNeeded[id] = true;
+			}
+		}
+
+		// cpXǂݍ܂񐔂𐔂.
+		std::vector<int> readCount(resourceList.size(), 0);
+		for (size_t i = 0; i < passList.size(); ++i) {
+			if (isAlive[i]) {
+				for (ResourceId id : passList[i].inputs) {
+					++readCount[id];
+				}
+			}
+		}
+
+		// ԃ\[XoR邾̃|XgGtFNgAÕ|XgGtFNgɂ܂Ƃ߂.
+		for (size_t i = 0; i < passList.size(); ++i) {
+			if (!isAlive[i]) {
+				continue;
+			}
+			const Pass& pass = passList[i];
+			if (pass.isEffect && !compiledList.empty()) {
+				Pass& prev = compiledList.back();
+				if (prev.isEffect && prev.output != backbuffer && prev.output == pass.inputs[0] &&
+					readCount[prev.output] == 1 && prev.lastOrder < pass.firstOrder) {
+					prev.name += "+" + pass.name;
+					prev.output = pass.output;
+					prev.defines.insert(prev.defines.end(), pass.defines.begin(), pass.defines.end());
+					prev.lastOrder = pass.lastOrder;
+					++stats.fusedCount;
+					continue;
+				}
+			}
+			compiledList.push_back(pass);
+		}
+
+		// e\[XgpX͈̔͂߂.
+		for (Resource& e : resourceList) {
+			e.firstPass = e.lastPass = e.target = -1;
+		}
+		for (int i = 0; i < static_cast<int>(compiledList.size()); ++i) {
+			const Pass& pass = compiledList[i];
+			std::vector<ResourceId> idList = pass.inputs;
+			idList.push_back(pass.output);
+			for (ResourceId id : idList) {
+				Resource& e = resourceList[id];
+				if (e.firstPass < 0) {
+					if (id != backbuffer && id != pass.output) {
+						std::cerr << "ERROR: '" << pass.name << "'ǂݍ'" << e.name << "'ɏރpX܂" << std::endl;
+						return false;
+					}
+					e.firstPass = i;
+				}
+				e.lastPass = i;
+			}
+		}
+
+		// gp͈͂̏dȂȂ\[XɁA傫̃ItXN[obt@g.
+		for (Target& e : targetList) {
+			e.busyUntil = -1;
+		}
+		for (int i = 0; i < static_cast<int>(compiledList.size()); ++i) {
+			for (ResourceId id = backbuffer + 1; id < static_cast<ResourceId>(resourceList.size()); ++id) {
+				Resource& e = resourceList[id];
+				if (e.firstPass != i) {
+					continue;
+				}
+				++stats.resourceCount;
+				const auto itr = std::find_if(targetList.begin(), targetList.end(), [&e, i](const Target& t) {
+					return t.width == e.width && t.height == e.height && t.busyUntil < i;
+				});
+				if (itr != targetList.end()) {
+					e.target = static_cast<int>(itr - targetList.begin());
+				} else {
+					OffscreenBufferPtr buffer = OffscreenBuffer::Create(e.width, e.height);
+					if (!buffer) {
+						std::cerr << "ERROR: '" << e.name << "'̃ItXN[obt@̍쐬Ɏs" << std::endl;
+						return false;
+					}
+					e.target = static_cast<int>(targetList.size());
+					targetList.push_back({ buffer, e.width, e.height, -1 });
+				}
+				targetList[e.target].busyUntil = e.lastPass;
+			}
+		}
+		stats.targetCount = std::count_if(targetList.begin(), targetList.end(), [](const Target& t) { return t.busyUntil >= 0; });
+
+		// ܂Ƃ߂}NŃ|XgGtFNg̃VF[_쐬.
+		for (Pass& pass : compiledList) {
+			if (!pass.isEffect) {
+				continue;
+			}
+			pass.program = createEffect(pass.defines);
+			if (!pass.program) {
+				std::cerr << "ERROR: '" << pass.name << "'̃VF[_̍쐬Ɏs" << std::endl;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	* pXԂɕ`悷.
+	*
+	* @param profiler pXƂGPȔԂvvt@C. nullptrȂvȂ.
+	*/
+	void Graph::Execute(GpuProfiler* profiler) const{
+		for (const Pass& pass : compiledList) {
+			const int marker = profiler ? profiler->Begin(pass.name.c_str()) : -1;
+			BindOutput(pass.output);
+			if (pass.isEffect) {
+				const Resource& input = resourceList[pass.inputs[0]];
+				const glm::vec2 texCoordScale(
+					static_cast<float>(input.viewportWidth) / static_cast<float>(input.width),
+					static_cast<float>(input.viewportHeight) / static_cast<float>(input.height));
+				drawEffect(pass.program, Texture(pass.inputs[0]), texCoordScale);
+			} else {
+				pass.func(*this);
+			}
+			if (profiler) {
+				profiler->End(marker);
+			}
+		}
+	}
+
+	/**
+	* \[XɊ蓖ĂeNX`擾.
+	*
+	* @param id \[X̎ʔԍ.
+	*
+	* @return eNX`ID. obNobt@܂͊蓖ĂĂȂ0.
+	*/
+	GLuint Graph::Texture(ResourceId id) const{
+		if (id <= backbuffer || id >= static_cast<ResourceId>(resourceList.size()) || resourceList[id].target < 0) {
+			return 0;
+		}
+		return targetList[resourceList[id].target].buffer->GetTexutre();
+	}
+
+	/**
+	* \[X`ɐݒ肵Ar[|[gƃVU[``͈͂ɍ킹.
+	*
+	* @param id \[X̎ʔԍ.
+	*/
+	void Graph::BindOutput(ResourceId id) const{
+		const Resource& e = resourceList[id];
+		if (id == backbuffer) {
+			GLState::BindFramebuffer(0);
+		} else {
+			GLState::BindFramebuffer(targetList[e.target].buffer->GetFramebuffer());
+		}
+		GLState::Viewport(0, 0, e.viewportWidth, e.viewportHeight);
+		GLState::Scissor(0, 0, e.viewportWidth, e.viewportHeight);
+	}
+
+} // namespace RenderGraph
@@ -0,0 +1,124 @@
+/**
+* @file RenderGraph.h
+*/
+#ifndef RENDERGRAPH_H_INCLUDED
+#define RENDERGRAPH_H_INCLUDED
+#include <GL/glew.h>
+#include "Shader.h"
+#include "OffscreenBuffer.h"
+#include "GpuProfiler.h"
+#include <glm/glm.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+* `pẌˑ֌W`揇ƕ`߂邽߂̖O.
+*
+* pX͓ǂݍރ\[XƏރ\[X錾ACompileŎ̏s.
+* - ŏIIɃobNobt@ɓ͂ȂpX菜.
+* - אڂSʃ|XgGtFNg̃pXA}N킹1̃VF[_ɂ܂Ƃ߂.
+* - gpԂdȂȂ\[XɓItXN[obt@蓖Ă.
+*/
+namespace RenderGraph {
+
+	class Graph;
+	typedef std::shared_ptr<Graph> GraphPtr; ///< _[Ot|C^^.
+
+	typedef int ResourceId; ///< \[X̎ʔԍ.
+	const ResourceId backbuffer = 0; ///< obNobt@\\[X.
+
+	/// pX̕`֐̌^. `Graphݒ肷.
+	typedef std::function<void(const Graph&)> ExecuteFunc;
+	/// |XgGtFNg̃}NVF[_쐬֐̌^.
+	typedef std::function<Shader::ProgramPtr(const Shader::DefineList&)> CreateEffectFunc;
+	/// |XgGtFNg̃VF[_œ̓eNX`Sʂɕ`悷֐̌^.
+	/// 3Ԗڂ̈́A̓eNX`̂`͈͂ǂݍނ߂̃eNX`W̊g嗦.
+	typedef std::function<void(const Shader::ProgramPtr&, GLuint, const glm::vec2&)> DrawEffectFunc;
+
+	/**
+	* OCompilě.
+	*/
+	struct Stats {
+		size_t passCount = 0; ///< 錾ꂽpX̐.
+		size_t culledCount = 0; ///< ʂgȂ̂Ŏ菜pX̐.
+		size_t fusedCount = 0; ///< ÕpXɂ܂Ƃ߂|XgGtFNg̃pX̐.
+		size_t resourceCount = 0; ///< `Ɏg郊\[X̐(obNobt@).
+		size_t targetCount = 0; ///< ۂɊ蓖ĂItXN[obt@̐.
+	};
+
+	/**
+	* _[Ot.
+	*/
+	class Graph {
+	public:
+		static GraphPtr Create(int width, int height, const CreateEffectFunc& createEffect, const DrawEffectFunc& drawEffect);
+
+		void Clear();
+		ResourceId CreateTarget(const char* name, int width, int height);
+		void Viewport(ResourceId id, int width, int height);
+		void AddPass(const char* name, const std::vector<ResourceId>& inputs, ResourceId output, const ExecuteFunc& func);
+		void AddEffectPass(const char* name, ResourceId input, ResourceId output, const char* define, int order);
+		bool Compile();
+		void Execute(GpuProfiler* profiler = nullptr) const;
+
+		GLuint Texture(ResourceId id) const;
+		const Stats& GetStats() const { return stats; }
+
+	private:
+		Graph() = default;
+		~Graph() = default;
+		Graph(const Graph&) = delete;
+		Graph& operator=(const Graph&) = delete;
+
+		/// `܂͓͂Ɏg\[X.
+		struct Resource {
+			std::string name;
+			int width;
+			int height;
+			int viewportWidth; ///< `͈͂̕. width菬΍̈ꕔg.
+			int viewportHeight; ///< `͈͂̍.
+			int firstPass; ///< ŏɎgpX̔ԍ(gȂ-1).
+			int lastPass; ///< ŌɎgpX̔ԍ.
+			int target; ///< 蓖ĂItXN[obt@̔ԍ(Ȃ-1).
+		};
+
+		/// `pX.
+		struct Pass {
+			std::string name;
+			std::vector<ResourceId> inputs;
+			ResourceId output;
+			ExecuteFunc func; ///< ʏ̃pX̕`֐.
+			bool isEffect; ///< Sʃ|XgGtFNg̃pXȂtrue.
+			Shader::DefineList defines; ///< |XgGtFNg̃}N.
+			int firstOrder; ///< |XgGtFNg̍ŏ̌ʂ̓Kp.
+			int lastOrder; ///< |XgGtFNg̍Ō̌ʂ̓Kp.
+			Shader::ProgramPtr program; ///< Compileō쐬|XgGtFNg̃VF[_.
+		};
+
+		/// \[XɊ蓖ĂItXN[obt@. ClearĂjɍėp.
+		struct Target {
+			OffscreenBufferPtr buffer;
+			int width;
+			int height;
+			int busyUntil; ///< ŌɎgpX̔ԍ. ̃pX̃\[XȂ犄蓖Ă.
+		};
+
+		void BindOutput(ResourceId id) const;
+
+	private:
+		int width = 0; ///< obNobt@̕.
+		int height = 0; ///< obNobt@̍.
+		CreateEffectFunc createEffect;
+		DrawEffectFunc drawEffect;
+		std::vector<Resource> resourceList;
+		std::vector<Pass> passList; ///< 錾ꂽpX.
+		std::vector<Pass> compiledList; ///< Compileō쐬Aۂɕ`悷pX.
+		std::vector<Target> targetList;
+		Stats stats;
+	};
+
+} // namespace RenderGraph
+
+#endif // RENDERGRAPH_H_INCLUDED
@@ -0,0 +1,89 @@
+/**
+* @file ResolutionScaler.cpp
+*/
+#include "ResolutionScaler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace /* unnamed */ {
+
+	/// `͈͂̕ƍ̒l̔{ɂ낦A킸ȎԂ̕ωŉ𑜓xς葱Ȃ悤ɂ.
+	const int sizeAlignment = 8;
+	/// ڕWԂɑ΂Ă̊A]TƂ݂Ȃ.
+	const double headroomRatio = 0.85;
+	/// ]TԂ̃t[𑜓xグ.
+	const int headroomFrames = 30;
+	/// 𑜓xグƂ̊g嗦̑.
+	const float scaleUpStep = 0.05f;
+
+} // unnamed namespace
+
+/**
+* .
+*
+* @param w        g嗦1̂Ƃ̕.
+* @param h        g嗦1̂Ƃ̍.
+* @param minScale ŏ̊g嗦.
+* @param maxScale ő̊g嗦. `͂̊g嗦̑傫Ŋmۂ邱.
+*/
+void ResolutionScaler::Init(int w, int h, float minScale, float maxScale){
+	baseWidth = w;
+	baseHeight = h;
+	this->minScale = minScale;
+	this->maxScale = std::max(minScale, maxScale);
+	maxWidth = static_cast<int>(std::ceil(w * this->maxScale));
+	maxHeight = static_cast<int>(std::ceil(h * this->maxScale));
+	scale = std::min(std::max(1.0f, this->minScale), this->maxScale);
+	width = std::min(static_cast<int>(w * scale), maxWidth);
+	height = std::min(static_cast<int>(h * scale), maxHeight);
+}
+
+/**
+* 𑜓x̕ύXL܂͖ɂ.
+*
+* @param enable          LɂȂtrue, ɂȂfalse.
+* @param targetFrameTime ڕWƂGPU̕`掞(~b).
+*
+* ɂƊg嗦1ɖ߂.
+*/
+void ResolutionScaler::Enable(bool enable, double targetFrameTime){
+	isEnabled = enable;
+	this->targetFrameTime = targetFrameTime;
+	headroomFrameCount = 0;
+	if (!isEnabled) {
+		scale = std::min(std::max(1.0f, minScale), maxScale);
+		width = std::min(static_cast<int>(baseWidth * scale), maxWidth);
+		height = std::min(static_cast<int>(baseHeight * scale), maxHeight);
+	}
+}
+
+/**
+* GPU̕`掞Ԃg嗦XV.
+*
+* @param gpuTime GPU̕`掞(~b).
+*
+* ɂȂĂƂ͉Ȃ.
+* `ɂ鎞Ԃ͉fA܂g嗦2ɂقڔႷ̂ŁA
+* ڕWԂ𒴂Ƃ1ŖڕWԂɎ܂g嗦܂ŉ.
+*/
+void ResolutionScaler::Update(double gpuTime){
+	if (!isEnabled) {
+		return;
+	}
+	gpuFrameTime = gpuTime;
+	if (gpuTime > targetFrameTime) {
+		scale *= static_cast<float>(std::sqrt(targetFrameTime * headroomRatio / gpuTime));
+		headroomFrameCount = 0;
+	} else if (gpuTime < targetFrameTime * headroomRatio) {
+		if (++headroomFrameCount >= headroomFrames) {
+			scale += scaleUpStep;
+			headroomFrameCount = 0;
+		}
+	} else {
+		headroomFrameCount = 0;
+	}
+	scale = std::min(std::max(scale, minScale), maxScale);
+	const auto align = [](int n) { return std::max(sizeAlignment, (n + sizeAlignment / 2) / sizeAlignment * sizeAlignment); };
+	width = std::min(align(static_cast<int>(baseWidth * scale)), maxWidth);
+	height = std::min(align(static_cast<int>(baseHeight * scale)), maxHeight);
+}
@@ -0,0 +1,50 @@
+/**
+* @file ResolutionScaler.h
+*/
+#ifndef RESOLUTIONSCALER_H_INCLUDED
+#define RESOLUTIONSCALER_H_INCLUDED
+
+/**
+* GPU̕`掞Ԃɍ킹3DV[̉𑜓xςNX.
+*
+* GpuProfilerŌvt[̕`掞ԂUpdateɓnƁA
+* ڕWԂ𒴂炷ɉ𑜓xA]TԂ班𑜓x߂.
+* `͍ő𑜓xŊmۂĂÄꕔgƂō蒼.
+*/
+class ResolutionScaler{
+public:
+	ResolutionScaler() = default;
+	~ResolutionScaler() = default;
+	ResolutionScaler(const ResolutionScaler&) = delete;
+	ResolutionScaler& operator=(const ResolutionScaler&) = delete;
+
+	void Init(int w, int h, float minScale = 0.5f, float maxScale = 1.0f);
+	void Enable(bool enable, double targetFrameTime);
+	bool IsEnabled() const { return isEnabled; }
+	void Update(double gpuTime);
+
+	float Scale() const { return scale; }
+	int Width() const { return width; }
+	int Height() const { return height; }
+	int MaxWidth() const { return maxWidth; }
+	int MaxHeight() const { return maxHeight; }
+	double GpuFrameTime() const { return gpuFrameTime; }
+
+private:
+	bool isEnabled = false;
+	double targetFrameTime = 1000.0 / 60.0; ///< ڕWƂGPU̕`掞(~b).
+	double gpuFrameTime = 0; ///< ŌUpdateɓnꂽGPU̕`掞(~b).
+	int headroomFrameCount = 0; ///< `掞Ԃɗ]T̂t[.
+
+	int baseWidth = 0; ///< g嗦1̂Ƃ̕.
+	int baseHeight = 0; ///< g嗦1̂Ƃ̍.
+	int maxWidth = 0; ///< `Ɋmۂ镝.
+	int maxHeight = 0; ///< `Ɋmۂ鍂.
+	float minScale = 0.5f;
+	float maxScale = 1.0f;
+	float scale = 1.0f; ///< ݂̊g嗦.
+	int width = 0; ///< ݂̕`͈͂̕.
+	int height = 0; ///< ݂̕`͈͂̍.
+};
+
+#endif // RESOLUTIONSCALER_H_INCLUDED
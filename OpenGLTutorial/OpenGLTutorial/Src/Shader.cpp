@@ -2,65 +2,403 @@
 * @file Shader.cpp
 */
 #include "Shader.h"
+#include "GLState.h"
 #include <vector>
+#include <algorithm>
+#include <unordered_map>
 #include <iostream>
 #include <cstdint>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h> 
+#ifdef _WIN32
+#include <direct.h>
+#endif
 
 namespace Shader {
+	namespace /* unnamed */ {
+		/**
+		* ^Tv[ǂ𒲂ׂ.
+		*
+		* @param type glGetActiveUniform Ŏ擾^.
+		*
+		* @retval true  Tv[.
+		* @retval false Tv[ȊO.
+		*/
+		bool IsSamplerType(GLenum type){
+			switch (type) {
+			case GL_SAMPLER_1D:
+			case GL_SAMPLER_2D:
+			case GL_SAMPLER_3D:
+			case GL_SAMPLER_CUBE:
+			case GL_SAMPLER_1D_SHADOW:
+			case GL_SAMPLER_2D_SHADOW:
+			case GL_SAMPLER_1D_ARRAY:
+			case GL_SAMPLER_2D_ARRAY:
+			case GL_SAMPLER_1D_ARRAY_SHADOW:
+			case GL_SAMPLER_2D_ARRAY_SHADOW:
+			case GL_SAMPLER_2D_MULTISAMPLE:
+			case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+			case GL_SAMPLER_CUBE_SHADOW:
+			case GL_SAMPLER_BUFFER:
+			case GL_SAMPLER_2D_RECT:
+			case GL_SAMPLER_2D_RECT_SHADOW:
+			case GL_INT_SAMPLER_1D:
+			case GL_INT_SAMPLER_2D:
+			case GL_INT_SAMPLER_3D:
+			case GL_INT_SAMPLER_CUBE:
+			case GL_INT_SAMPLER_1D_ARRAY:
+			case GL_INT_SAMPLER_2D_ARRAY:
+			case GL_INT_SAMPLER_2D_MULTISAMPLE:
+			case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+			case GL_INT_SAMPLER_BUFFER:
+			case GL_INT_SAMPLER_2D_RECT:
+			case GL_UNSIGNED_INT_SAMPLER_1D:
+			case GL_UNSIGNED_INT_SAMPLER_2D:
+			case GL_UNSIGNED_INT_SAMPLER_3D:
+			case GL_UNSIGNED_INT_SAMPLER_CUBE:
+			case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY:
+			case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+			case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+			case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+			case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+			case GL_UNSIGNED_INT_SAMPLER_2D_RECT:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		/// vOEoCiۑfBNg.
+		const char programCacheDir[] = "ProgramCache";
+
+		/**
+		* vOEoCiEt@C̐擪ɒu.
+		*/
+		struct ProgramBinaryHeader {
+			char magic[4]; ///< "PBIN".
+			GLenum format; ///< glGetProgramBinaryŎ擾oCi`.
+			GLint length; ///< oCĩoCg.
+		};
+
+		ProgramCacheStats cacheStats; ///< vOEoCiELbV̗p.
+
+		/// SẴvOœjbggTv[̖Oƃjbgԍ̕\.
+		std::unordered_map<std::string, GLint> fixedSamplerUnitMap;
+
+		/// t@Cƃ}N̑gݍ킹쐬ς݂̃vO邽߂̕\.
+		std::unordered_map<std::string, std::weak_ptr<Program>> permutationCache;
+
+		/**
+		* vOEoCi𗘗pł邩ׂ.
+		*
+		* @retval true  pł.
+		* @retval false płȂ.
+		*/
+		bool IsProgramBinarySupported(){
+			if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) {
+				return false;
+			}
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			return formatCount > 0;
+		}
+
+		/**
+		* FNV-1aŃoCg̃nbVlvZ.
+		*
+		* @param hash O܂ł̃nbVl.
+		* @param data oCgւ̃|C^.
+		* @param size oCg.
+		*
+		* @return nbVl.
+		*/
+		uint64_t HashBytes(uint64_t hash, const void* data, size_t size){
+			const uint8_t* p = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				hash = (hash ^ p[i]) * 0x100000001b3ULL;
+			}
+			return hash;
+		}
+
+		/**
+		* vOEoCĩt@C쐬.
+		*
+		* @param vsCode _VF[_R[hւ̃|C^.
+		* @param fsCode tOgVF[_R[hւ̃|C^.
+		*
+		* @return VF[_R[hƃhCo񂩂쐬t@C.
+		*
+		* hCoXVƃoCi͎gȂȂ̂ŁAhCoL[Ɋ܂߂.
+		*/
+		std::string ProgramCachePath(const GLchar* vsCode, const GLchar* fsCode){
+			uint64_t hash = 0xcbf29ce484222325ULL;
+			for (const GLchar* code : { vsCode, fsCode }) {
+				hash = HashBytes(hash, code, strlen(code) + 1);
+			}
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+				const char* str = reinterpret_cast<const char*>(glGetString(name));
+				if (str) {
+					hash = HashBytes(hash, str, strlen(str) + 1);
+				}
+			}
+			char filename[64];
+			snprintf(filename, sizeof(filename), "/%016llx.bin", static_cast<unsigned long long>(hash));
+			return std::string(programCacheDir) + filename;
+		}
+
+		/**
+		* t@CvOEoCiǂݍ.
+		*
+		* @param path t@C.
+		*
+		* @return 쐬vOIuWFNg. ǂݍ߂Ȃ0.
+		*/
+		GLuint LoadProgramBinary(const std::string& path){
+			FILE* fp = fopen(path.c_str(), "rb");
+			if (!fp) {
+				return 0;
+			}
+			ProgramBinaryHeader header;
+			std::vector<char> binary;
+			bool isValid = fread(&header, sizeof(header), 1, fp) == 1 &&
+				memcmp(header.magic, "PBIN", 4) == 0 && header.length > 0;
+			if (isValid) {
+				binary.resize(header.length);
+				isValid = fread(binary.data(), 1, binary.size(), fp) == binary.size();
+			}
+			fclose(fp);
+			if (!isValid) {
+				return 0;
+			}
+			GLuint program = glCreateProgram();
+			glProgramBinary(program, header.format, binary.data(), header.length);
+			GLint linkStatus = GL_FALSE;
+			glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+			if (linkStatus != GL_TRUE) {
+				// hCo󂯕tȂoCi͍蒼.
+				glDeleteProgram(program);
+				return 0;
+			}
+			return program;
+		}
+
+		/**
+		* vOEoCit@Cɕۑ.
+		*
+		* @param path    t@C.
+		* @param program ۑvOIuWFNg.
+		*/
+		void SaveProgramBinary(const std::string& path, GLuint program){
+			ProgramBinaryHeader header = { { 'P', 'B', 'I', 'N' } };
+			glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &header.length);
+			if (header.length <= 0) {
+				return;
+			}
+			std::vector<char> binary(header.length);
+			glGetProgramBinary(program, header.length, nullptr, &header.format, binary.data());
+			if (glGetError() != GL_NO_ERROR) {
+				return;
+			}
+#ifdef _WIN32
+			_mkdir(programCacheDir);
+#else
+			mkdir(programCacheDir, 0755);
+#endif
+			FILE* fp = fopen(path.c_str(), "wb");
+			if (!fp) {
+				std::cerr << "WARNING: " << path << "쐬ł܂" << std::endl;
+				return;
+			}
+			fwrite(&header, sizeof(header), 1, fp);
+			fwrite(binary.data(), 1, binary.size(), fp);
+			fclose(fp);
+		}
+	} // unnamed namespace
+
+	/**
+	* vOEoCiELbV̗p󋵂擾.
+	*
+	* @return NẴLbV̗p.
+	*/
+	const ProgramCacheStats& GetProgramCacheStats(){
+		return cacheStats;
+	}
+
+	/**
+	* SẴvOœeNX`EC[WEjbggTv[o^.
+	*
+	* @param samplerName Tv[.
+	* @param unit        蓖ĂeNX`EC[WEjbg̔ԍ.
+	*
+	* o^Tv[̓vOƂ̘AԂ̑ΏۂÔŁA
+	* t[ƂɈxeNX`蓖Ă΁Aǂ̃vOQƂł.
+	* o^Oɍ쐬vOɂ͔fȂ.
+	*/
+	void FixedSamplerUnit(const char* samplerName, GLint unit){
+		fixedSamplerUnitMap[samplerName] = unit;
+	}
+
 	/**
 	* VF[_vO쐬.
 	*
 	* @param vsCode        _VF[_R[hւ̃|C^.
 	* @param fsCode        tOgVF[_R[hւ̃|C^.
+	* @param defines       ̃VF[_ɒ`}ÑXg.
 	*
 	* @return 쐬vOIuWFNg.
+	*         t@Cƃ}N̑gݍ킹ō쐬ς݂̃vO΁AԂ.
 	*/
-	ProgramPtr Program::Create(const char* vsFilename, const char* fsFilename){
-		struct Impl : Program {
-			Impl() {}
-			~Impl() {}
-		};
-		ProgramPtr p = std::make_shared<Impl>();
-		if (!p) {
-			std::cerr << "ERROR: vO'" << vsFilename << "'̍쐬Ɏs" << std::endl;
+	ProgramPtr Program::Create(const char* vsFilename, const char* fsFilename, const DefineList& defines){
+		ProgramPtr p = Submit(vsFilename, fsFilename, defines);
+		if (!p || !p->Finish()) {
 			return{};
 		}
-		p->program = CreateProgramFromFile(vsFilename, fsFilename);
-		if (!p->program) {
-			return{};
+		return p;
+	}
+
+	/**
+	* Nς݃vOuniformϐƃubN̏擾.
+	*
+	* @retval true  擾.
+	* @retval false 擾s.
+	*
+	* Tv[ɂ͏oɃeNX`EC[WEjbg蓖āAňxݒ肷.
+	* z̃Tv[ɂ͗vf̘Ajbg蓖Ă.
+	* FixedSamplerUnitœo^Tv[ɂ͓o^jbg蓖Ă.
+	*/
+	bool Program::Reflect(){
+		GLint activeUniforms = 0;
+		glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &activeUniforms);
+		GLint maxNameLength = 0;
+		glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		std::vector<GLchar> nameBuf(std::max(maxNameLength, 1));
+		uniformList.reserve(activeUniforms);
+		samplerCount = 0;
+		bool hasSampler = false;
+		for (GLint i = 0; i < activeUniforms; ++i) {
+			UniformInfo info;
+			glGetActiveUniform(program, i, static_cast<GLsizei>(nameBuf.size()), nullptr, &info.size, &info.type, nameBuf.data());
+			info.location = glGetUniformLocation(program, nameBuf.data());
+			if (info.location < 0) {
+				continue; // ubÑo̓ubNPʂŋL^.
+			}
+			info.name = nameBuf.data();
+			const std::string::size_type bracket = info.name.find('[');
+			if (bracket != std::string::npos) {
+				info.name.resize(bracket);
+			}
+			info.unit = -1;
+			if (IsSamplerType(info.type)) {
+				const auto itr = fixedSamplerUnitMap.find(info.name);
+				if (itr != fixedSamplerUnitMap.end()) {
+					info.unit = itr->second;
+				} else {
+					info.unit = samplerCount;
+					samplerCount += info.size;
+				}
+				hasSampler = true;
+			}
+			uniformList.push_back(info);
 		}
-		// Tv[̐ƈʒu擾.
-		GLint activeUniforms;
-		glGetProgramiv(p->program, GL_ACTIVE_UNIFORMS, &activeUniforms);
-		for (int i = 0; i < activeUniforms; ++i) {
-			GLint size;
-			GLenum type;
-			GLchar name[128];
-			glGetActiveUniform(p->program, i, sizeof(name), nullptr, &size, &type, name);
-			if (type == GL_SAMPLER_2D) {
-				p->samplerCount = size;
-				p->samplerLocation = glGetUniformLocation(p->program, name);
-				if (p->samplerLocation < 0) {
-					std::cerr << "ERROR: vO'" << vsFilename << "'̍쐬Ɏs" << std::endl;
-					return{};
+
+		// Tv[̃jbg̓vOƂɌŒȂ̂ŁANɈxݒ肷.
+		if (hasSampler) {
+			GLState::UseProgram(program);
+			std::vector<GLint> units;
+			for (const UniformInfo& e : uniformList) {
+				if (e.unit >= 0) {
+					units.resize(e.size);
+					for (GLint i = 0; i < e.size; ++i) {
+						units[i] = e.unit + i;
+					}
+					glUniform1iv(e.location, e.size, units.data());
 				}
-				break;
 			}
 		}
 
-		// _VF[_[t@C̖".vert"菜̂vOƂ.
-		p->name = vsFilename;
-		p->name.resize(p->name.size() - 4);
+		GLint activeUniformBlocks = 0;
+		glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &activeUniformBlocks);
+		for (GLint i = 0; i < activeUniformBlocks; ++i) {
+			GLint length = 0;
+			glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_NAME_LENGTH, &length);
+			std::vector<GLchar> blockName(std::max(length, 1));
+			glGetActiveUniformBlockName(program, i, static_cast<GLsizei>(blockName.size()), nullptr, blockName.data());
+			BlockInfo info = { blockName.data(), GL_UNIFORM_BLOCK, static_cast<GLuint>(i), 0 };
+			glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_DATA_SIZE, &info.dataSize);
+			blockList.push_back(info);
+		}
 
-		return p;
+		if (GLEW_VERSION_4_3 || GLEW_ARB_program_interface_query) {
+			GLint activeStorageBlocks = 0;
+			glGetProgramInterfaceiv(program, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &activeStorageBlocks);
+			for (GLint i = 0; i < activeStorageBlocks; ++i) {
+				const GLenum props[] = { GL_NAME_LENGTH, GL_BUFFER_DATA_SIZE };
+				GLint values[2] = {};
+				glGetProgramResourceiv(program, GL_SHADER_STORAGE_BLOCK, i, 2, props, 2, nullptr, values);
+				std::vector<GLchar> blockName(std::max(values[0], 1));
+				glGetProgramResourceName(program, GL_SHADER_STORAGE_BLOCK, i, static_cast<GLsizei>(blockName.size()), nullptr, blockName.data());
+				blockList.push_back({ blockName.data(), GL_SHADER_STORAGE_BLOCK, static_cast<GLuint>(i), values[1] });
+			}
+		}
+		return glGetError() == GL_NO_ERROR;
+	}
+
+	/**
+	* ftHgEubNuniformϐ̏擾.
+	*
+	* @param uniformName ϐ. z̏ꍇ"[0]"tȂO.
+	*
+	* @return ϐ̏ւ̃|C^. Ȃnullptr.
+	*/
+	const UniformInfo* Program::FindUniform(const char* uniformName) const{
+		for (const UniformInfo& e : uniformList) {
+			if (e.name == uniformName) {
+				return &e;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	* ftHgEubNuniformϐ̈ʒu擾.
+	*
+	* @param uniformName ϐ.
+	*
+	* @return ϐ̈ʒu. Ȃ-1.
+	*/
+	GLint Program::UniformLocation(const char* uniformName) const{
+		const UniformInfo* p = FindUniform(uniformName);
+		return p ? p->location : -1;
+	}
+
+	/**
+	* ubN̏擾.
+	*
+	* @param blockType GL_UNIFORM_BLOCK ܂ GL_SHADER_STORAGE_BLOCK.
+	* @param blockName ubN.
+	*
+	* @return ubN̏ւ̃|C^. Ȃnullptr.
+	*/
+	const BlockInfo* Program::FindBlock(GLenum blockType, const char* blockName) const{
+		for (const BlockInfo& e : blockList) {
+			if (e.blockType == blockType && e.name == blockName) {
+				return &e;
+			}
+		}
+		return nullptr;
 	}
 
 	/**
 	* fXgN^.
 	*/
 	Program::~Program(){
+		if (vs) {
+			glDeleteShader(vs);
+		}
+		if (fs) {
+			glDeleteShader(fs);
+		}
 		if (program) {
 			glDeleteProgram(program);
 		}
@@ -74,30 +412,58 @@ namespace Shader {
 	*
 	* @retval true  蓖Đ.
 	* @retval false 蓖Ďs.
+	*
+	* CX^X`p̃vOݒ肳Ă΁Aɂ蓖Ăs.
 	*/
 	bool Program::UniformBlockBinding(const char* blockName, GLuint bindingPoint){
-		const GLuint blockIndex = glGetUniformBlockIndex(program, blockName);
-		if (blockIndex == GL_INVALID_INDEX) {
+		const BlockInfo* block = FindBlock(GL_UNIFORM_BLOCK, blockName);
+		if (!block) {
 			std::cerr << "ERROR(" << name <<"): UniformubN'" << blockName << "'܂" << std::endl;
 			return false;
 		}
-		glUniformBlockBinding(program, blockIndex, bindingPoint);
+		glUniformBlockBinding(program, block->index, bindingPoint);
 		const GLenum result = glGetError();
 		if (result != GL_NO_ERROR) {
 			std::cerr << "ERROR(" << name << "): UniformubN'" << blockName << "'̃oChɎs" << std::endl;
 			return false;
 		}
+		if (instanced) {
+			return instanced->UniformBlockBinding(blockName, bindingPoint);
+		}
+		return true;
+	}
+
+	/**
+	* VF[_EXg[WEubNoCfBOE|CgɊ蓖Ă.
+	*
+	* @param blockName    蓖ĂVF[_EXg[WEubN̖O.
+	* @param bindingPoint 蓖Đ̃oCfBOE|Cg.
+	*
+	* @retval true  蓖Đ.
+	* @retval false 蓖Ďs.
+	*/
+	bool Program::ShaderStorageBlockBinding(const char* blockName, GLuint bindingPoint){
+		const BlockInfo* block = FindBlock(GL_SHADER_STORAGE_BLOCK, blockName);
+		if (!block) {
+			std::cerr << "ERROR(" << name << "): VF[_EXg[WEubN'" << blockName << "'܂" << std::endl;
+			return false;
+		}
+		glShaderStorageBlockBinding(program, block->index, bindingPoint);
+		const GLenum result = glGetError();
+		if (result != GL_NO_ERROR) {
+			std::cerr << "ERROR(" << name << "): VF[_EXg[WEubN'" << blockName << "'̃oChɎs" << std::endl;
+			return false;
+		}
 		return true;
 	}
 
 	/**
 	* `pvOɐݒ肷.
+	*
+	* Tv[̃jbg͍쐬ɐݒς݂Ȃ̂ŁAvO̐؂ւs.
 	*/
 	void Program::UseProgram(){
-		glUseProgram(program);
-		for (GLint i = 0; i < samplerCount; ++i) {
-			glUniform1i(samplerLocation + i, i);
-		}
+		GLState::UseProgram(program);
 	}
 
 	/**
@@ -106,26 +472,45 @@ namespace Shader {
 	* @param unit    蓖Đ̃eNX`EC[WEjbgԍ(GL_TEXTURE0`).
 	* @param type    蓖ĂeNX`̎(GL_TEXTURE_1D, GL_TEXTURE_2D, etc).
 	* @param texture 蓖ĂeNX`IuWFNg.
+	*
+	* @retval true  蓖Ă.
+	* @retval false unit̃vÕTv[͈̔͊OȂ̂Ŋ蓖ĂȂ.
 	*/
-	void Program::BindTexture(GLenum unit, GLenum type, GLuint texture){
+	bool Program::BindTexture(GLenum unit, GLenum type, GLuint texture){
 		if (unit >= GL_TEXTURE0 && unit < static_cast<GLenum>(GL_TEXTURE0 + samplerCount)) {
-			glActiveTexture(unit);
-			glBindTexture(type, texture);
+			GLState::BindTexture(unit - GL_TEXTURE0, type, texture);
+			return true;
 		}
+		return false;
 	}
 
 	/**
-	* VF[_R[hRpC.
+	* VF[_R[h̃RpCJn.
 	*
 	* @param type VF[_̎.
 	* @param string VF[_R[hւ̃|C^.
 	*
 	* @return 쐬VF[_IuWFNg.
+	*
+	* RpCɑΉhCoł́ARpC̊҂ɖ߂.
+	* ʂCheckShaderŊmF邱.
 	*/
 	GLuint CompileShader(GLenum type, const GLchar* string) {
 		GLuint shader = glCreateShader(type);
 		glShaderSource(shader, 1, &string, nullptr);
 		glCompileShader(shader);
+		return shader;
+	}
+
+	/**
+	* VF[_̃RpCʂmF.
+	*
+	* @param shader mFVF[_IuWFNg.
+	*
+	* @retval true  RpC.
+	* @retval false RpCs.
+	*/
+	bool CheckShader(GLuint shader) {
 		GLint compiled = 0;
 		glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
 		if (!compiled) {
@@ -139,32 +524,42 @@ namespace Shader {
 					std::cerr << "ERROR: VF[_̃RpCɎs\n" << buf.data() << std::endl;
 				}
 			}
-			glDeleteShader(shader);
-			return 0;
+			return false;
 		}
-		return shader;
+		return true;
 	}
 
 	/**
-	* vOIuWFNg쐬.
+	* vOIuWFNg̃NJn.
 	*
-	* @param vsCode _VF[_R[hւ̃|C^.
-	* @param fsCode tOgVF[_R[hւ̃|C^.
+	* @param vs _VF[_IuWFNg.
+	* @param fs tOgVF[_IuWFNg.
 	*
 	* @return 쐬vOIuWFNg.
+	*
+	* RpCɑΉhCoł́AN̊҂ɖ߂.
+	* ʂCheckProgramŊmF邱.
 	*/
-	GLuint CreateShaderProgram(const GLchar* vsCode, const GLchar* fsCode) {
-		GLuint vs = CompileShader(GL_VERTEX_SHADER, vsCode);
-		GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fsCode);
-		if (!vs || !fs) {
-			return 0;
-		}
+	GLuint LinkProgram(GLuint vs, GLuint fs) {
 		GLuint program = glCreateProgram();
+		if (IsProgramBinarySupported()) {
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
 		glAttachShader(program, fs);
-		glDeleteShader(fs);
 		glAttachShader(program, vs);
-		glDeleteShader(vs);
 		glLinkProgram(program);
+		return program;
+	}
+
+	/**
+	* vOIuWFNg̃NʂmF.
+	*
+	* @param program mFvOIuWFNg.
+	*
+	* @retval true  N.
+	* @retval false Ns.
+	*/
+	bool CheckProgram(GLuint program) {
 		GLint linkStatus = GL_FALSE;
 		glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
 		if (linkStatus != GL_TRUE) {
@@ -178,10 +573,9 @@ namespace Shader {
 					std::cerr << "ERROR: VF[_̃NɎs\n" << buf.data() << std::endl;
 				}
 			}
-			glDeleteProgram(program);
-			return 0;
+			return false;
 		}
-		return program;
+		return true;
 	}
 
 	/**
@@ -213,14 +607,58 @@ namespace Shader {
 	}
 
 	/**
-	* t@CVF[_vO쐬.
+	* VF[_R[hɃ}N`}.
 	*
-	* @param vsCode _VF[_t@C.
-	* @param fsCode tOgVF[_t@C.
+	* @param buf     VF[_R[hi[obt@.
+	* @param defines }}ÑXg.
 	*
-	* @return 쐬vOIuWFNg.
+	* #version͐擪ɂȂ΂ȂȂ̂ŁA̎̍sɑ}.
+	* G[bZ[W̍sԍςȂ悤ɁA}#lineōsԍ߂.
+	*/
+	void InsertDefines(std::vector<char>& buf, const DefineList& defines){
+		if (defines.empty()) {
+			return;
+		}
+		std::string code(buf.data());
+		std::string::size_type pos = 0;
+		int nextLine = 1;
+		if (code.compare(0, 8, "#version") == 0) {
+			pos = code.find('\n');
+			pos = (pos == std::string::npos) ? code.size() : pos + 1;
+			nextLine = 2;
+		}
+		std::string defineCode;
+		if (pos == code.size()) {
+			defineCode += '\n';
+		}
+		for (const std::string& e : defines) {
+			defineCode += "#define " + e + "\n";
+		}
+		defineCode += "#line " + std::to_string(nextLine) + "\n";
+		code.insert(pos, defineCode);
+		buf.assign(code.begin(), code.end());
+		buf.push_back('\0');
+	}
+
+	/**
+	* t@CVF[_vO̍쐬Jn.
+	*
+	* @param vsFilename _VF[_t@C.
+	* @param fsFilename tOgVF[_t@C.
+	* @param defines    ̃VF[_ɒ`}ÑXg.
+	* @param vs         RpC̒_VF[_IuWFNgi[ϐ.
+	* @param fs         RpC̃tOgVF[_IuWFNgi[ϐ.
+	* @param cachePath  vOEoCĩt@Ci[ϐ.
+	*
+	* @return 쐬vOIuWFNg. t@Cǂݍ߂Ȃ0.
+	*
+	* LbVǂݍ񂾏ꍇAvsfs0ɂȂ.
+	* łȂFinishProgramŌʂmF܂vsfsێ邱.
 	*/
-	GLuint CreateProgramFromFile(const char* vsFilename, const char* fsFilename){
+	GLuint SubmitProgram(const char* vsFilename, const char* fsFilename, const DefineList& defines,
+		GLuint& vs, GLuint& fs, std::string& cachePath){
+		vs = fs = 0;
+		cachePath.clear();
 		std::vector<char> vsBuf;
 		if (!ReadFile(vsFilename, vsBuf)) {
 			std::cerr << "ERROR in Shader::CreateProgramFromFile:\n" << vsFilename << "ǂݍ߂܂." << std::endl;
@@ -231,6 +669,242 @@ namespace Shader {
 			std::cerr << "ERROR in Shader::CreateProgramFromFile:\n" << fsFilename << "ǂݍ߂܂." << std::endl;
 			return 0;
 		}
-		return CreateShaderProgram(vsBuf.data(), fsBuf.data());
+		// }N}̃R[hLbṼL[ɂ̂ŁAgݍ킹Ƃɕʂ̃oCiɂȂ.
+		InsertDefines(vsBuf, defines);
+		InsertDefines(fsBuf, defines);
+		if (IsProgramBinarySupported()) {
+			// VF[_R[hƃhCoō쐬oCi΁ARpCɎg.
+			cachePath = ProgramCachePath(vsBuf.data(), fsBuf.data());
+			const GLuint program = LoadProgramBinary(cachePath);
+			if (program) {
+				++cacheStats.hitCount;
+				return program;
+			}
+			++cacheStats.missCount;
+		}
+		vs = CompileShader(GL_VERTEX_SHADER, vsBuf.data());
+		fs = CompileShader(GL_FRAGMENT_SHADER, fsBuf.data());
+		return LinkProgram(vs, fs);
+	}
+
+	/**
+	* SubmitProgramŊJnVF[_vO̍쐬.
+	*
+	* @param program   vOIuWFNg. sꍇ͍폜0ݒ肷.
+	* @param vs        _VF[_IuWFNg. 폜0ݒ肷.
+	* @param fs        tOgVF[_IuWFNg. 폜0ݒ肷.
+	* @param cachePath vOEoCĩt@C. łȂ΍쐬vOۑ.
+	*
+	* @retval true  쐬.
+	* @retval false 쐬s.
+	*/
+	bool FinishProgram(GLuint& program, GLuint& vs, GLuint& fs, const std::string& cachePath){
+		if (!vs && !fs) {
+			return program != 0; // LbVǂݍ.
+		}
+		const bool result = CheckShader(vs) && CheckShader(fs) && CheckProgram(program);
+		glDeleteShader(vs);
+		glDeleteShader(fs);
+		vs = fs = 0;
+		if (!result) {
+			glDeleteProgram(program);
+			program = 0;
+			return false;
+		}
+		if (!cachePath.empty()) {
+			SaveProgramBinary(cachePath, program);
+		}
+		return true;
+	}
+
+	/**
+	* t@CVF[_vO쐬.
+	*
+	* @param vsCode  _VF[_t@C.
+	* @param fsCode  tOgVF[_t@C.
+	* @param defines ̃VF[_ɒ`}ÑXg.
+	*
+	* @return 쐬vOIuWFNg.
+	*/
+	GLuint CreateProgramFromFile(const char* vsFilename, const char* fsFilename, const DefineList& defines){
+		GLuint vs, fs;
+		std::string cachePath;
+		GLuint program = SubmitProgram(vsFilename, fsFilename, defines, vs, fs, cachePath);
+		if (!program || !FinishProgram(program, vs, fs, cachePath)) {
+			return 0;
+		}
+		return program;
+	}
+
+	/**
+	* RpC𗘗pł邩ׂ.
+	*
+	* @retval true  pł.
+	* @retval false płȂ.
+	*/
+	bool IsParallelCompileSupported(){
+		return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+	}
+
+	/**
+	* VF[_vO̍쐬Jn.
+	*
+	* @param vsFilename _VF[_t@C.
+	* @param fsFilename tOgVF[_t@C.
+	* @param defines    ̃VF[_ɒ`}ÑXg.
+	*
+	* @return 쐬̃vO. t@Cǂݍ߂Ȃnullptr.
+	*         gpOFinishĂяo.
+	*
+	* t@Cƃ}N̑gݍ킹̃vOcĂ΁AVɍ쐬ɂԂ.
+	*/
+	ProgramPtr Program::Submit(const char* vsFilename, const char* fsFilename, const DefineList& defines){
+		// }N̏Ⴄ̑gݍ킹͓vOƂĈ.
+		DefineList sortedDefines = defines;
+		std::sort(sortedDefines.begin(), sortedDefines.end());
+		std::string key = std::string(vsFilename) + '\n' + fsFilename;
+		for (const std::string& e : sortedDefines) {
+			key += '\n' + e;
+		}
+		const auto itr = permutationCache.find(key);
+		if (itr != permutationCache.end()) {
+			if (ProgramPtr p = itr->second.lock()) {
+				return p;
+			}
+		}
+
+		struct Impl : Program {
+			Impl() {}
+			~Impl() {}
+		};
+		ProgramPtr p = std::make_shared<Impl>();
+		if (!p) {
+			std::cerr << "ERROR: vO'" << vsFilename << "'̍쐬Ɏs" << std::endl;
+			return{};
+		}
+		// _VF[_[t@C̖".vert"菜̂vOƂ.
+		p->name = vsFilename;
+		p->name.resize(p->name.size() - 4);
+		if (!sortedDefines.empty()) {
+			// t@C쐬̑gݍ킹Ƌʂł悤ɁA}Nt.
+			for (size_t i = 0; i < sortedDefines.size(); ++i) {
+				p->name += (i == 0 ? '(' : ',') + sortedDefines[i];
+			}
+			p->name += ')';
+		}
+
+		p->program = SubmitProgram(vsFilename, fsFilename, sortedDefines, p->vs, p->fs, p->cachePath);
+		if (!p->program) {
+			return{};
+		}
+		p->isPending = true;
+		permutationCache[key] = p;
+		return p;
+	}
+
+	/**
+	* RpCƃNĂ邩ׂ.
+	*
+	* @retval true  Ă. Finish͂ɖ߂.
+	* @retval false ĂȂ. Finish̓hCȍ҂.
+	*
+	* RpC𗘗płȂꍇ͏trueԂ.
+	*/
+	bool Program::IsReady() const{
+		if (!isPending || (!vs && !fs) || !IsParallelCompileSupported()) {
+			return true;
+		}
+		GLint isCompleted = GL_FALSE;
+		glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &isCompleted);
+		return isCompleted == GL_TRUE;
+	}
+
+	/**
+	* VF[_vO̍쐬.
+	*
+	* @retval true  쐬.
+	* @retval false 쐬s.
+	*
+	* ŇʂmFAtNV擾.
+	* 2ڈȍ~̌Ăяo͍ŏ̌ʂԂ.
+	*/
+	bool Program::Finish(){
+		if (!isPending) {
+			return program != 0;
+		}
+		isPending = false;
+		if (!FinishProgram(program, vs, fs, cachePath) || !Reflect()) {
+			std::cerr << "ERROR: vO'" << name << "'̍쐬Ɏs" << std::endl;
+			if (program) {
+				glDeleteProgram(program);
+				program = 0;
+			}
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	* RXgN^.
+	*
+	* GL_KHR_parallel_shader_compile gꍇAhCoɃRpCEXbh̐C.
+	*/
+	ProgramBatch::ProgramBatch(){
+		if (GLEW_KHR_parallel_shader_compile) {
+			glMaxShaderCompilerThreadsKHR(0xffffffff);
+		} else if (GLEW_ARB_parallel_shader_compile) {
+			glMaxShaderCompilerThreadsARB(0xffffffff);
+		}
+	}
+
+	/**
+	* VF[_vO̍쐬Jn.
+	*
+	* @param vsFilename _VF[_t@C.
+	* @param fsFilename tOgVF[_t@C.
+	* @param defines    ̃VF[_ɒ`}ÑXg.
+	*
+	* @return 쐬̃vO. 쐬Ɏsꍇnullptr.
+	*         FinishĂяo܂ŎgpĂ͂ȂȂ.
+	*
+	* RpC𗘗płȂꍇ́Aō쐬.
+	*/
+	ProgramPtr ProgramBatch::Add(const char* vsFilename, const char* fsFilename, const DefineList& defines){
+		ProgramPtr p = Program::Submit(vsFilename, fsFilename, defines);
+		if (!p) {
+			return{};
+		}
+		if (!IsParallelCompileSupported()) {
+			if (!p->Finish()) {
+				return{};
+			}
+			return p;
+		}
+		programList.push_back(p);
+		return p;
+	}
+
+	/**
+	* ǉSẴVF[_vO̍쐬.
+	*
+	* @retval true  Sč쐬.
+	* @retval false 쐬ɎsvO.
+	*
+	* vO珇ɏÂȂΐ擪̃vO҂.
+	*/
+	bool ProgramBatch::Finish(){
+		bool result = true;
+		while (!programList.empty()) {
+			auto itr = std::find_if(programList.begin(), programList.end(),
+				[](const ProgramPtr& p) { return p->IsReady(); });
+			if (itr == programList.end()) {
+				itr = programList.begin();
+			}
+			if (!(*itr)->Finish()) {
+				result = false;
+			}
+			programList.erase(itr);
+		}
+		return result;
 	}
 }//namespace Shader
\ No newline at end of file
@@ -6,22 +6,65 @@
 #include <GL/glew.h>
 #include <string>
 #include <memory>
+#include <vector>
 
 
 namespace Shader {
 	class Program;
 	typedef std::shared_ptr<Program> ProgramPtr; ///< vOIuWFNg|C^^.
 
+	/**
+	* VF[_ɒ`}ÑXg.
+	*
+	* evf"NAME"܂"NAME VALUE"̌`ŁA#version̒#defineƂđ}.
+	*/
+	typedef std::vector<std::string> DefineList;
+
+	/**
+	* ftHgEubNuniformϐ̏.
+	*/
+	struct UniformInfo {
+		std::string name; ///< ϐ. z̏ꍇ"[0]"O.
+		GLint location; ///< ʒu.
+		GLenum type; ///< ^(GL_FLOAT_VEC4, GL_SAMPLER_2D, etc).
+		GLint size; ///< z̗vf. złȂ1.
+		GLint unit; ///< Tv[Ɋ蓖ĂeNX`EC[WEjbg̔ԍ. Tv[łȂ-1.
+	};
+
+	/**
+	* UniformubN܂̓VF[_EXg[WEubN̏.
+	*/
+	struct BlockInfo {
+		std::string name; ///< ubN.
+		GLenum blockType; ///< GL_UNIFORM_BLOCK ܂ GL_SHADER_STORAGE_BLOCK.
+		GLuint index; ///< ubNECfbNX.
+		GLint dataSize; ///< ubÑoCg. VF[_EXg[WEubN͉ϒ܂܂Ȃ.
+	};
+
 	/**
 	* VF[_[vONX.
 	*/
 	class Program{
 	public:
-		static ProgramPtr Create(const char* vsFilename, const char* fsFilename);
+		static ProgramPtr Create(const char* vsFilename, const char* fsFilename, const DefineList& defines = DefineList());
+
+		bool IsReady() const;
+		bool Finish();
 
 		bool UniformBlockBinding(const char* blockName, GLuint bindingPoint);
+		bool ShaderStorageBlockBinding(const char* blockName, GLuint bindingPoint);
 		void UseProgram();
-		void BindTexture(GLenum unit, GLenum type, GLuint texture);
+		bool BindTexture(GLenum unit, GLenum type, GLuint texture);
+		GLuint Id() const { return program; }
+		const UniformInfo* FindUniform(const char* uniformName) const;
+		GLint UniformLocation(const char* uniformName) const;
+		const BlockInfo* FindBlock(GLenum blockType, const char* blockName) const;
+		const std::vector<UniformInfo>& UniformList() const { return uniformList; }
+		const std::vector<BlockInfo>& BlockList() const { return blockList; }
+		void Instanced(const ProgramPtr& p) { instanced = p; }
+		const ProgramPtr& Instanced() const { return instanced; }
+		void Indirect(const ProgramPtr& p) { indirect = p; }
+		const ProgramPtr& Indirect() const { return indirect; }
 
 	private:
 		Program() = default;
@@ -29,14 +72,54 @@ namespace Shader {
 		Program(const Program&) = delete;
 		Program& operator=(const Program&) = delete;
 
+	private:
+		friend class ProgramBatch;
+		static ProgramPtr Submit(const char* vsFilename, const char* fsFilename, const DefineList& defines);
+		bool Reflect();
+
 	private:
 		GLuint program = 0; ///< vOIuWFNg.
-		GLint samplerLocation = -1; ///< Tv[̈ʒu.
-		int samplerCount = 0; ///< Tv[̐.
+		int samplerCount = 0; ///< Tv[Ɋ蓖ĂeNX`EC[WEjbg̐.
+		std::vector<UniformInfo> uniformList; ///< ftHgEubNuniformϐ̈ꗗ.
+		std::vector<BlockInfo> blockList; ///< ubN̈ꗗ.
 		std::string name; ///< vO.
+		ProgramPtr instanced; ///< `sCX^X`p̃vO.
+		ProgramPtr indirect; ///< `sԐڕ`p̃vO.
+
+		bool isPending = false; ///< Finishō쐬Kvtrue.
+		GLuint vs = 0; ///< RpC̒_VF[_.
+		GLuint fs = 0; ///< RpC̃tOgVF[_.
+		std::string cachePath; ///< vOEoCĩt@C.
+	};
+
+	/**
+	* ̃VF[_vO܂Ƃ߂č쐬NX.
+	*
+	* AddőSẴvÕRpCJnĂFinishŊ҂ƂŁA
+	* hCõRpCƑ̏s.
+	* GL_KHR_parallel_shader_compile gȂꍇAAdd͂̏ō쐬.
+	*/
+	class ProgramBatch {
+	public:
+		ProgramBatch();
+		ProgramPtr Add(const char* vsFilename, const char* fsFilename, const DefineList& defines = DefineList());
+		bool Finish();
+
+	private:
+		std::vector<ProgramPtr> programList; ///< 쐬ĂȂvÕXg.
+	};
+
+	/**
+	* vOEoCiELbV̗p.
+	*/
+	struct ProgramCacheStats {
+		int hitCount = 0; ///< LbVǂݍ񂾃vO̐.
+		int missCount = 0; ///< LbVɂȂ߃RpCvO̐.
 	};
 
-	GLuint CreateProgramFromFile(const char* vsFilename, const char* fsFilename);
+	GLuint CreateProgramFromFile(const char* vsFilename, const char* fsFilename, const DefineList& defines = DefineList());
+	const ProgramCacheStats& GetProgramCacheStats();
+	void FixedSamplerUnit(const char* samplerName, GLint unit);
 }
 
 #endif // !SHADER_H_INCLUDED
\ No newline at end of file
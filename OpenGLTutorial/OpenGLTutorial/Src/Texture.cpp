@@ -3,6 +3,7 @@
 */
 
 #include "Texture.h"
+#include "GLState.h"
 #include <iostream>
 #include <vector>
 #include <stdint.h>
@@ -30,6 +31,9 @@ uint32_t Get(const uint8_t* p, size_t offset, size_t size){
 }
 
 
+/// LoadFromFile ō쐬eNX`z̑w̐.
+static const int defaultArrayLayerCount = 8;
+
 /**
 * RXgN^.
 */
@@ -41,7 +45,7 @@ Texture::Texture() : texId(0), width(0), height(0){
 * fXgN^.
 */
 Texture::~Texture(){
-	if (texId) {
+	if (texId && !array) {
 		glDeleteTextures(1, &texId);
 	}
 }
@@ -71,7 +75,7 @@ TexturePtr Texture::Create(int width, int height, GLenum iformat, GLenum format,
 	p->width = width;
 	p->height = height;
 	glGenTextures(1, &p->texId);
-	glBindTexture(GL_TEXTURE_2D, p->texId);
+	GLState::BindTexture(0, GL_TEXTURE_2D, p->texId);
 	glTexImage2D(GL_TEXTURE_2D, 0, iformat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
 	const GLenum result = glGetError();
 	if (result != GL_NO_ERROR) {
@@ -87,20 +91,110 @@ TexturePtr Texture::Create(int width, int height, GLenum iformat, GLenum format,
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
 	// eNX`̊蓖Ă
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::BindTexture(0, GL_TEXTURE_2D, 0);
 	
 	return p;
 }
 
+/**
+* 2DeNX`z쐬.
+*
+* @param width      ew̕(sNZ).
+* @param height     ew̍(sNZ).
+* @param iformat    eNX`̃f[^`.
+* @param layerCount w̐.
+*
+* @return 쐬ɐꍇ̓eNX`|C^Ԃ.
+*         sꍇnullptrԂ.
+*
+* 쐬͂ǂ̑wgĂȂ. 摜 CreateLayer Ő擪̑w珇ɏ.
+*/
+TexturePtr Texture::CreateArray(int width, int height, GLenum iformat, int layerCount){
+	struct impl : Texture {
+		impl() {};
+		~impl() {};
+	};
+	TexturePtr p = std::make_shared<impl>();
+
+	p->width = width;
+	p->height = height;
+	p->target = GL_TEXTURE_2D_ARRAY;
+	p->iformat = iformat;
+	p->layerCount = layerCount;
+	glGenTextures(1, &p->texId);
+	GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, p->texId);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, iformat, width, height, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	const GLenum result = glGetError();
+	if (result != GL_NO_ERROR) {
+		std::cerr << "ERROR in Texture::CreateArray(0x" << std::hex << result << std::dec << ")" << std::endl;
+		GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, 0);
+		return{};
+	}
+
+	// Create ō쐬2DeNX`Ɠp[^ɂ.
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, 0);
+
+	return p;
+}
+
+/**
+* eNX`z̖gp̑wɉ摜.
+*
+* @param array  ݐ̃eNX`z.
+* @param format 摜f[^̗vf.
+* @param data   摜f[^ւ̃|C^. 傫̓eNX`z̊ewƓłȂ΂ȂȂ.
+*
+* @return 쐬ɐꍇ́A񂾑w\eNX`|C^Ԃ.
+*         eNX`zɋ󂫂ȂꍇnullptrԂ.
+*
+* ԂꂽeNX` Id() ŃeNX`zIDALayer() őw̔ԍԂ.
+*/
+TexturePtr Texture::CreateLayer(const TexturePtr& array, GLenum format, const void* data){
+	if (!array || array->target != GL_TEXTURE_2D_ARRAY || array->IsFull()) {
+		return{};
+	}
+	struct impl : Texture {
+		impl() {};
+		~impl() {};
+	};
+	TexturePtr p = std::make_shared<impl>();
+
+	p->texId = array->texId;
+	p->width = array->width;
+	p->height = array->height;
+	p->target = GL_TEXTURE_2D_ARRAY;
+	p->layer = array->usedLayerCount;
+	p->array = array;
+	GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, array->texId);
+	glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, p->layer, p->width, p->height, 1, format, GL_UNSIGNED_BYTE, data);
+	GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, 0);
+	const GLenum result = glGetError();
+	if (result != GL_NO_ERROR) {
+		std::cerr << "ERROR in Texture::CreateLayer(0x" << std::hex << result << std::dec << ")" << std::endl;
+		return{};
+	}
+	++array->usedLayerCount;
+	return p;
+}
+
 /**
 * t@C2DeNX`ǂݍ.
 *
-* @param filename t@C.
+* @param filename  t@C.
+* @param arrayList ǂݍ񂾉摜i[eNX`z̃Xg. nullptrȂ2DeNX`쐬.
+*                  傫ƃf[^`ŋ󂫂̂eNX`z񂪂΁Ȃwɉ摜.
+*                  ȂΐVeNX`z쐬ăXgɒǉ.
 *
 * @return 쐬ɐꍇ̓eNX`|C^Ԃ.
 *         sꍇnullptrԂ.
 */
-TexturePtr Texture::LoadFromFile(const char* filename){
+TexturePtr Texture::LoadFromFile(const char* filename, std::vector<TexturePtr>* arrayList){
 
 	// stat֐Ńt@CTCY擾
 	struct stat st;
@@ -159,5 +253,19 @@ TexturePtr Texture::LoadFromFile(const char* filename){
 	}
 
 	// eNX`쐬
-	return Create(width, height, GL_RGB8, GL_BGR, buf.data() + offsetBytes);
+	if (!arrayList) {
+		return Create(width, height, GL_RGB8, GL_BGR, buf.data() + offsetBytes);
+	}
+	for (const TexturePtr& e : *arrayList) {
+		if (e->width == static_cast<int>(width) && e->height == static_cast<int>(height) &&
+			e->iformat == GL_RGB8 && !e->IsFull()) {
+			return CreateLayer(e, GL_BGR, buf.data() + offsetBytes);
+		}
+	}
+	TexturePtr array = CreateArray(width, height, GL_RGB8, defaultArrayLayerCount);
+	if (!array) {
+		return{};
+	}
+	arrayList->push_back(array);
+	return CreateLayer(array, GL_BGR, buf.data() + offsetBytes);
 }
@@ -6,6 +6,7 @@
 #define OPENGLTUTORIAL_SRC_TEXTURE_H_INCLUDED
 #include <GL/glew.h>
 #include <memory>
+#include <vector>
 
 class Texture;
 // テクスチャポインタ
@@ -19,11 +20,22 @@ class Texture{
 public:
 
 	static TexturePtr Create(int width, int height, GLenum iformat, GLenum format, const void* data);
-	static TexturePtr LoadFromFile(const char*);
+	static TexturePtr CreateArray(int width, int height, GLenum iformat, int layerCount);
+	static TexturePtr CreateLayer(const TexturePtr& array, GLenum format, const void* data);
+	static TexturePtr LoadFromFile(const char*, std::vector<TexturePtr>* arrayList = nullptr);
 
+	/// テクスチャ配列の層なら、層を含むテクスチャ配列のIDを返す.
 	GLuint Id() const { return texId; }
 	GLsizei Width() const { return width; }
 	GLsizei Height() const { return height; }
+	/// 割り当てに使うテクスチャの種類(GL_TEXTURE_2D または GL_TEXTURE_2D_ARRAY).
+	GLenum Target() const { return target; }
+	/// テクスチャ配列の層の番号. テクスチャ配列の層でなければ0.
+	GLint Layer() const { return layer; }
+	/// 層を含むテクスチャ配列. テクスチャ配列の層でなければnullptr.
+	const TexturePtr& Array() const { return array; }
+	/// テクスチャ配列の全ての層を使っていればtrue.
+	bool IsFull() const { return usedLayerCount >= layerCount; }
 
 private:
 	Texture();
@@ -34,6 +46,12 @@ private:
 	GLuint texId;
 	int width;
 	int height;
+	GLenum target = GL_TEXTURE_2D;
+	GLenum iformat = GL_NONE; ///< テクスチャのデータ形式(テクスチャ配列のみ).
+	GLint layer = 0;
+	int layerCount = 0; ///< 層の数(テクスチャ配列のみ).
+	int usedLayerCount = 0; ///< 使用済みの層の数(テクスチャ配列のみ).
+	TexturePtr array; ///< 層を含むテクスチャ配列. 層はテクスチャ配列のIDを共有するので、削除しないように保持する.
 };
 
 #endif // OPENGLTUTORIAL_SRC_TEXTURE_H_INCLUDED
\ No newline at end of file
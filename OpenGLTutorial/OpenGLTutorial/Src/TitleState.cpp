@@ -9,12 +9,12 @@
 namespace GameState {
 
 	/// wi̍XV.
-	void UpdateSpaceSphere(Entity::Entity& entity, double delta){
+	void UpdateSpaceSphere(double delta){
 
 		// wiƉ].
-		glm::vec3 rotSpace = glm::eulerAngles(entity.Rotation());
-		rotSpace.x += static_cast<float>(glm::radians(2.5) * delta);
-		entity.Rotation(rotSpace);
+		GameEngine& game = GameEngine::Instance();
+		const float angle = static_cast<float>(glm::radians(2.5) * delta);
+		game.BackgroundRotation(game.BackgroundRotation() * glm::angleAxis(angle, glm::vec3(1, 0, 0)));
 	}
 
 	/// ^Cgʂ̍XV.
@@ -23,11 +23,13 @@ namespace GameState {
 		GameEngine& game = GameEngine::Instance();
 		game.Camera({ glm::vec4(0, 20, -8, 1), glm::vec3(0, 0, 12), glm::vec3(0, 0, 1) });
 
-		if (!pSpaceSphere) {
-			// wiGeBeB쐬.
-			pSpaceSphere = game.AddEntity(EntityGroupId_Others, glm::vec3(0, 0, 0),
-				"SpaceSphere", "Res/SpaceSphere.bmp", &UpdateSpaceSphere, "NonLighting");
+		if (!hasSpaceSphere) {
+			// wi͂]邾Ȃ̂ŁAL[u}bvɈx`悵Ă.
+			// t[͕s̃GeBeB̌ɍő[x̑Sʕ`1s.
+			hasSpaceSphere = true;
+			game.BakeBackground("SpaceSphere", "Res/SpaceSphere.bmp");
 		}
+		UpdateSpaceSphere(delta);
 
 		const float offset = timer == 0 ? 0 : (2.0f - timer) * (2.0f - timer) * 2.0f;
 		game.FontScale(glm::vec2(2));
@@ -37,7 +39,7 @@ namespace GameState {
 		if (timer > 0) {
 			timer -= static_cast<float>(delta);
 			if (timer <= 0) {
-				game.UpdateFunc(MainGame(pSpaceSphere));
+				game.UpdateFunc(MainGame());
 			}
 		}else if (game.GetGamePad().buttonDown & GamePad::START) {
 			game.PlayAudio(1, CRI_SAMPLECUESHEET_START);
@@ -6,29 +6,80 @@
 #include <glm/glm.hpp>
 
 namespace Uniform {
-	/// _VF[_̃p[^^.
+	/**
+	* _VF[_̃p[^^(GeBeBƂ̃f[^).
+	*
+	* fsMVPśÃf[^FrameData璸_VF[_ŌvZ.
+	*/
 	struct VertexData {
-		glm::mat4 matMVP;
-		glm::mat4 matModel;
-		glm::mat3x4 matNormal;
-		glm::vec4 color;
+		glm::vec3 position; ///< W.
+		glm::uint32 color; ///< F(packUnorm4x8RGBA8rbgl߂).
+		glm::vec4 rotation; ///< ](NH[^jIx, y, z, w).
+		glm::vec3 scale; ///< 傫.
+		glm::uint32 layer; ///< eNX`z̑w(16rbg̓J[A16rbg̓m[}}bv).
+	};
+
+	/**
+	* CeBOsȂVF[_p̒_VF[_̃p[^^.
+	*
+	* 傫͎Ƃɔx_A]snorm16ɗʎq.
+	*/
+	struct CompactVertexData {
+		glm::vec3 position; ///< W.
+		glm::uint32 scale; ///< 傫XY(packHalf2x16ŋl߂). Zlayeȑ16rbgɊi[.
+		glm::uint32 rotation[2]; ///< ](NH[^jIxyzwpackSnorm2x16ŋl߂).
+		glm::uint32 color; ///< F(packUnorm4x8RGBA8rbgl߂).
+		glm::uint32 layer; ///< 16rbg̓J[eNX`z̑wA16rbg͑傫Z(x_).
+	};
+
+	/**
+	* t[ƂɈxXVp[^.
+	*/
+	struct FrameData {
+		glm::mat4 matView; ///< r[s.
+		glm::mat4 matProj; ///< vWFNVs.
+		glm::mat4 matVP; ///< r[EvWFNVs.
+		float time; ///< Q[Jňoߎ(b).
+		float deltaTime; ///< Õt[̌oߎ(b).
+		float dummy[2]; ///< std140̂߂̋lߕ.
+	};
+
+	/// CX^X`1xɕ`łGeBeB̍ő吔(VF[_VertexDataz̗vf).
+	const int maxInstanceCount = 64;
+
+	/**
+	* Ԑڕ`ŕ`CfbNXƂɎQƂf[^.
+	*/
+	struct DrawData {
+		glm::uint32 instance; ///< `悷GeBeB̃yC[hz̔ԍ.
 	};
 
 	/**
 	* Cgf[^(_).
 	*/
 	struct PointLight {
-		glm::vec4 position; ///< W([hWn).
+		glm::vec4 position; ///< xyz: W([hWn). w: e͈(GameEngine邳vZ).
 		glm::vec4 color; ///< 邳.
 	};
 
-	const int maxLightCount = 4; ///< Cg̐. 
+	const int maxLightCount = 256; ///< Cg̍ő吔.
+	const int fixedLightCount = 4; ///< GameEngine::LightŐݒ肷郉Cg̐. c̓t[Ƃɒǉ.
+
+	/**
+	* tOgVF[_̑郉CgNX^߂邽߂̃p[^.
+	*/
+	struct ClusterData {
+		glm::vec4 tileScale; ///< xy: ʍW^CԍɕϊW. zw: [x̑ΐXCXԍɕϊWƒ萔.
+		glm::vec4 depthParams; ///< [xobt@̒lr[Wn̐[xɕϊW(near*far, far, far-near, gp).
+		glm::uvec4 count; ///< xyz: Əc̃^CAXCX.
+	};
 
 	/**
 	* CeBOp[^.
 	*/
 	struct LightData {
 		glm::vec4 ambientColor; ///< .
+		ClusterData cluster; ///< CgNX^̃p[^.
 		PointLight light[maxLightCount]; ///< Cg̃Xg.
 	};
 
@@ -2,7 +2,11 @@
 * @file UniformBuffer.cpp
 */
 #include "UniformBuffer.h"
+#include "GLState.h"
+#include "GLRecorder.h"
 #include <iostream>
+#include <chrono>
+#include <string.h>
 
 /**
 * Uniformobt@쐬.
@@ -10,10 +14,18 @@
 * @param size         obt@̃oCgTCY.
 * @param bindingPoint obt@蓖ĂoCfBOE|Cg.
 * @param name         obt@(fobOp).
+* @param frameCount   Oobt@̃t[(1`maxFrameCount).
+*                     2ȏ̏ꍇAsizeoCg̗̈t[mۂ.
+*                     GL_ARB_buffer_storage gΉiIɃ}bvA
+*                     gȂ΃t[ƂɓȂŃ}bv.
 *
 * @return 쐬Uniformobt@ւ̃|C^.
 */
-UniformBufferPtr UniformBuffer::Create(GLsizeiptr size, GLuint bindingPoint, const char* name){
+UniformBufferPtr UniformBuffer::Create(GLsizeiptr size, GLuint bindingPoint, const char* name, int frameCount){
+	if (frameCount < 1 || frameCount > maxFrameCount) {
+		std::cerr << "ERROR: UBO '" << name << "'̃t[(" << frameCount << ")͈͊Oł" << std::endl;
+		return{};
+	}
 
 	struct Impl : UniformBuffer {
 		Impl() {}
@@ -25,10 +37,25 @@ UniformBufferPtr UniformBuffer::Create(GLsizeiptr size, GLuint bindingPoint, con
 		return{};
 	}
 
+	// et[̗̈̐擪 BindBufferRange Ɏwł悤ɁÄ̑傫Eɍ킹.
+	const GLintptr alignment = OffsetAlignment();
+	p->frameCount = frameCount;
+	p->frameSize = frameCount > 1 ? (size + alignment - 1) / alignment * alignment : size;
+	const GLsizeiptr totalSize = p->frameSize * frameCount;
 	glGenBuffers(1, &p->ubo);
 	glBindBuffer(GL_UNIFORM_BUFFER, p->ubo);
-	glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
-	glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, p->ubo);
+	if (frameCount > 1 && (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage)) {
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_UNIFORM_BUFFER, totalSize, nullptr, flags);
+		p->persistentPointer = static_cast<GLubyte*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, totalSize, flags));
+	} else {
+		glBufferData(GL_UNIFORM_BUFFER, totalSize, nullptr, GL_DYNAMIC_DRAW);
+	}
+	if (frameCount > 1) {
+		GLState::BindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, p->ubo, 0, size);
+	} else {
+		GLState::BindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, p->ubo);
+	}
 	const GLenum result = glGetError();
 	if (result != GL_NO_ERROR) {
 		std::cerr << "ERROR: UBO '" << name << "'̍쐬Ɏs" << std::endl;
@@ -42,15 +69,81 @@ UniformBufferPtr UniformBuffer::Create(GLsizeiptr size, GLuint bindingPoint, con
 	return p;
 }
 
+/**
+* BindBufferRange ɎwłItZbg̋E擾.
+*
+* @return ItZbg͂̒l̔{łȂ΂ȂȂ.
+*/
+GLintptr UniformBuffer::OffsetAlignment(){
+	static GLint alignment = 0;
+	if (!alignment) {
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		if (alignment <= 0) {
+			alignment = 256; // 擾łȂ΁Am̎ōő̒lg.
+		}
+	}
+	return alignment;
+}
+
 /**
 * fXgN^.
 */
 UniformBuffer::~UniformBuffer(){
+	for (GLsync sync : fence) {
+		if (sync) {
+			glDeleteSync(sync);
+		}
+	}
 	if (ubo) {
+		// iIȃ}bv̓obt@̍폜ŉ.
 		glDeleteBuffers(1, &ubo);
 	}
 }
 
+/**
+* ݂̃t[̗̈g`̊҂.
+*
+* ҂Ԃ FenceWaitTime() Ŏ擾ł.
+*/
+void UniformBuffer::WaitFrame() const{
+	GLsync& sync = fence[frameIndex];
+	if (!sync) {
+		return;
+	}
+	const auto start = std::chrono::steady_clock::now();
+	GLenum result = glClientWaitSync(sync, 0, 0);
+	while (result == GL_TIMEOUT_EXPIRED) {
+		result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000 * 1000);
+	}
+	if (result == GL_WAIT_FAILED) {
+		std::cerr << "WARNING(" << name << "): tFX̑ҋ@Ɏs" << std::endl;
+	}
+	glDeleteSync(sync);
+	sync = nullptr;
+	const std::chrono::duration<double> waitTime = std::chrono::steady_clock::now() - start;
+	fenceWaitTime += waitTime.count();
+}
+
+/**
+* Oobt@̎̃t[̗̈ɐ؂ւ.
+*
+* ݂̃t[̗̈g`施߂SĔsɌĂяo.
+* ؂ւ̈̓oCfBOE|CgɊ蓖Ă.
+* Oobt@łȂΉȂ.
+*/
+void UniformBuffer::NextFrame(){
+	if (frameCount <= 1) {
+		return;
+	}
+	if (fence[frameIndex]) {
+		glDeleteSync(fence[frameIndex]);
+	}
+	fence[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	frameIndex = (frameIndex + 1) % frameCount;
+	fenceWaitTime = 0;
+	GLState::BindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, ubo, FrameOffset(), size);
+}
+
 /**
 * Uniformobt@Ƀf[^].
 *
@@ -73,6 +166,25 @@ bool UniformBuffer::BufferSubData(const GLvoid* data, GLintptr offset, GLsizeipt
 	if (offset == 0 && size == 0) {
 		size = this->size;
 	}
+	if (frameCount > 1) {
+		// `撆̗̈Ȃ悤ɁAtFXŕی삳ꂽ݂̃t[̗̈ɒڏ.
+		WaitFrame();
+		if (persistentPointer) {
+			memcpy(persistentPointer + FrameOffset() + offset, data, size);
+			GLRecorder::PersistentWrite(ubo, FrameOffset() + offset, size, data);
+			return true;
+		}
+		glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+		void* p = glMapBufferRange(GL_UNIFORM_BUFFER, FrameOffset() + offset, size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (!p) {
+			std::cerr << "ERROR(" << name << "): obt@̃}bvɎs" << std::endl;
+			return false;
+		}
+		memcpy(p, data, size);
+		glUnmapBuffer(GL_UNIFORM_BUFFER);
+		return true;
+	}
 	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
 	glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
 	return true;
@@ -81,26 +193,43 @@ bool UniformBuffer::BufferSubData(const GLvoid* data, GLintptr offset, GLsizeipt
 /**
 * w肳ꂽ͈͂oCfBOE|CgɊ蓖Ă.
 *
-* @param offset 蓖Ă͈͂̃oCgItZbg.
+* @param offset 蓖Ă͈͂̃oCgItZbg(Oobt@̏ꍇ݂͌̃t[̗̈̐擪).
 * @param size   蓖Ă͈͂̃oCg.
 */
 void UniformBuffer::BindBufferRange(GLintptr offset, GLsizeiptr size) const{
-	glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, ubo, offset, size);
+	GLState::BindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, ubo, FrameOffset() + offset, size);
 }
 
 /**
 * UBOVXeɃ}bv.
 *
 * @return }bvւ̃|C^.
+*         Oobt@̏ꍇ݂͌̃t[̗̈̐擪w.
 */
 void* UniformBuffer::MapBuffer() const{
+	if (frameCount > 1) {
+		WaitFrame();
+		if (persistentPointer) {
+			return persistentPointer + FrameOffset();
+		}
+		glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+		return glMapBufferRange(GL_UNIFORM_BUFFER, FrameOffset(), size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	}
 	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
 	return glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
 }
 
 /**
 * obt@̊蓖Ă.
+*
+* iIɃ}bvĂꍇ͉Ã݂t[̗̈ւ݂̏ GLRecorder ɒm点.
 */
 void UniformBuffer::UnmapBuffer() const{
+	if (persistentPointer) {
+		GLRecorder::PersistentWrite(ubo, FrameOffset(), size, persistentPointer + FrameOffset());
+		return;
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
 	glUnmapBuffer(GL_UNIFORM_BUFFER);
 }
\ No newline at end of file
@@ -12,15 +12,25 @@ typedef std::shared_ptr<UniformBuffer> UniformBufferPtr; ///< UBO
 
 /**
 * UBONX.
+*
+* frameCount 2ȏw肵č쐬ƁAobt@t[̗̈ɕOobt@ɂȂ.
+* ݂Ɗ蓖Ă݂͌̃t[̗̈ɑ΂čsANextFrame Ŏ̗̈ɐ؂ւ.
+* ̈ėpOɁÄ̗g`̊tFXő҂.
 */
 class UniformBuffer {
 public:
-	static UniformBufferPtr Create(GLsizeiptr size, GLuint bindingPoint, const char* name);
+	static UniformBufferPtr Create(GLsizeiptr size, GLuint bindingPoint, const char* name, int frameCount = 1);
+	static GLintptr OffsetAlignment();
 	GLsizeiptr Size() const { return size; }
 	bool BufferSubData(const GLvoid* data, GLintptr offset = 0, GLsizeiptr size = 0);
 	void BindBufferRange(GLintptr offset, GLsizeiptr size) const;
 	void* MapBuffer() const;
 	void UnmapBuffer() const;
+	void NextFrame();
+	bool IsPersistent() const { return persistentPointer != nullptr; }
+	double FenceWaitTime() const { return fenceWaitTime; }
+
+	static const int maxFrameCount = 4; ///< Oobt@̍őt[.
 
 private:
 	UniformBuffer() = default;
@@ -28,11 +38,20 @@ private:
 	UniformBuffer(const UniformBuffer&) = delete;
 	UniformBuffer& operator=(const UniformBuffer&) = delete;
 
+	GLintptr FrameOffset() const { return frameIndex * frameSize; }
+	void WaitFrame() const;
+
 private:
 	GLuint ubo = 0; ///< Uniform Buffer Object.
-	GLsizeiptr size = 0; ///< UBÕoCgTCY.
+	GLsizeiptr size = 0; ///< UBÕoCgTCY(Oobt@̏ꍇ1t[).
 	GLuint bindingPoint; ///< UBO̊蓖ĂĐoCfBOE|Cg.
 	std::string name; ///< UBO.
+	int frameCount = 1; ///< Oobt@̃t[.
+	int frameIndex = 0; ///< ݂̃t[̗̈ԍ.
+	GLsizeiptr frameSize = 0; ///< 1t[̗̈̃oCg(Eɍ킹).
+	GLubyte* persistentPointer = nullptr; ///< iIɃ}bvobt@ւ̃|C^.
+	mutable GLsync fence[maxFrameCount] = {}; ///< ëg`̊҂߂̃tFX.
+	mutable double fenceWaitTime = 0; ///< ݂̃t[ŃtFX̊҂(b).
 };
 
 #endif // UNIFORMBUFFER_H_INCLUDED
\ No newline at end of file